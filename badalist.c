@@ -1,19 +1,370 @@
+/* needed for mremap */
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
 #include "badalist.h"
 
+#include <limits.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "badalloc.h"
 #include "badlib.h"
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BLIB_ALIST_SIMD
+#include <immintrin.h>
+#endif
+
+/* Arrays at least this many bytes large are allocated with mmap and grown with
+ * mremap, which can move the pages to a new address instead of copying them.
+ */
+#ifdef __linux__
+#define BLIB_ALIST_MREMAP
+#include <sys/mman.h>
+#include <unistd.h>
+#ifndef BLIB_ALIST_MMAP_THRESHOLD
+#define BLIB_ALIST_MMAP_THRESHOLD ((size_t)64 << 20)
+#endif
+#endif
+
+#define BLIB_ALIST_DEFAULT_GROWTH 200
+
+#define WORD_BITS (sizeof(unsigned long) * CHAR_BIT)
+#define WORD_COUNT(CAP) (((CAP) + WORD_BITS - 1) / WORD_BITS)
+
 static BlibError last_status = BLIB_SUCCESS;
 
+/* scan kernels
+ *
+ * Each kernel looks for slots holding `target`. The SIMD versions test 8
+ * slots at a time and fall back to the scalar loop for the tail; the AVX2
+ * versions are only used if the CPU supports them.
+ */
+static size_t scan_first_scalar(void *const *data, size_t n,
+                                const void *target) {
+  size_t i;
+  for (i = 0; i < n; ++i)
+    if (data[i] == target) return i;
+  return n;
+}
+
+static size_t scan_last_scalar(void *const *data, size_t n,
+                               const void *target) {
+  size_t i;
+  for (i = n; i > 0; --i)
+    if (data[i - 1] == target) return i - 1;
+  return n;
+}
+
+#ifdef BLIB_ALIST_SIMD
+/* bit i of the result is set if slots[i] == target */
+static unsigned scan_mask_sse2(void *const *slots, __m128i pattern) {
+  unsigned mask = 0, i;
+  for (i = 0; i < 8; i += 2) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(slots + i));
+    unsigned m = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, pattern)));
+    /* a pointer matches only if both of its 32-bit halves do */
+    mask |= ((m & (m >> 1) & 1) | ((m >> 2) & (m >> 3) & 1) << 1) << i;
+  }
+  return mask;
+}
+
+static __m128i scan_pattern_sse2(const void *target) {
+  const void *pattern[2];
+  pattern[0] = pattern[1] = target;
+  return _mm_loadu_si128((const __m128i *)pattern);
+}
+
+static size_t scan_first_sse2(void *const *data, size_t n,
+                              const void *target) {
+  __m128i pattern = scan_pattern_sse2(target);
+  size_t i;
+  for (i = 0; i + 8 <= n; i += 8) {
+    unsigned mask = scan_mask_sse2(data + i, pattern);
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  i += scan_first_scalar(data + i, n - i, target);
+  return i;
+}
+
+static size_t scan_last_sse2(void *const *data, size_t n,
+                             const void *target) {
+  __m128i pattern = scan_pattern_sse2(target);
+  size_t i, tail = n % 8, found;
+  if ((found = scan_last_scalar(data + n - tail, tail, target)) != tail)
+    return n - tail + found;
+  for (i = n - tail; i > 0; i -= 8) {
+    unsigned mask = scan_mask_sse2(data + i - 8, pattern);
+    if (mask) return i - 8 + (31 - __builtin_clz(mask));
+  }
+  return n;
+}
+
+__attribute__((target("avx2"))) static unsigned scan_mask_avx2(
+    void *const *slots, __m256i pattern) {
+  __m256i lo = _mm256_loadu_si256((const __m256i *)slots);
+  __m256i hi = _mm256_loadu_si256((const __m256i *)(slots + 4));
+  unsigned m_lo =
+      _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lo, pattern)));
+  unsigned m_hi =
+      _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(hi, pattern)));
+  return m_lo | m_hi << 4;
+}
+
+__attribute__((target("avx2"))) static __m256i scan_pattern_avx2(
+    const void *target) {
+  const void *pattern[4];
+  pattern[0] = pattern[1] = pattern[2] = pattern[3] = target;
+  return _mm256_loadu_si256((const __m256i *)pattern);
+}
+
+__attribute__((target("avx2"))) static size_t scan_first_avx2(
+    void *const *data, size_t n, const void *target) {
+  __m256i pattern = scan_pattern_avx2(target);
+  size_t i;
+  for (i = 0; i + 8 <= n; i += 8) {
+    unsigned mask = scan_mask_avx2(data + i, pattern);
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  i += scan_first_scalar(data + i, n - i, target);
+  return i;
+}
+
+__attribute__((target("avx2"))) static size_t scan_last_avx2(
+    void *const *data, size_t n, const void *target) {
+  __m256i pattern = scan_pattern_avx2(target);
+  size_t i, tail = n % 8, found;
+  if ((found = scan_last_scalar(data + n - tail, tail, target)) != tail)
+    return n - tail + found;
+  for (i = n - tail; i > 0; i -= 8) {
+    unsigned mask = scan_mask_avx2(data + i - 8, pattern);
+    if (mask) return i - 8 + (31 - __builtin_clz(mask));
+  }
+  return n;
+}
+
+static int scan_has_avx2(void) {
+  static int has_avx2 = -1;
+  if (has_avx2 < 0) has_avx2 = __builtin_cpu_supports("avx2") != 0;
+  return has_avx2;
+}
+
+static size_t scan_first(void *const *data, size_t n, const void *target) {
+  return scan_has_avx2() ? scan_first_avx2(data, n, target)
+                         : scan_first_sse2(data, n, target);
+}
+
+static size_t scan_last(void *const *data, size_t n, const void *target) {
+  return scan_has_avx2() ? scan_last_avx2(data, n, target)
+                         : scan_last_sse2(data, n, target);
+}
+
+#else
+#define scan_first scan_first_scalar
+#define scan_last scan_last_scalar
+#endif
+
 /* internal functions */
+/* index of the lowest set bit; word must be nonzero */
+static unsigned bit_first(unsigned long word) {
+#ifdef __GNUC__
+  return __builtin_ctzl(word);
+#else
+  unsigned i = 0;
+  for (; !(word & 1); word >>= 1) ++i;
+  return i;
+#endif
+}
+
+/* index of the highest set bit; word must be nonzero */
+static unsigned bit_last(unsigned long word) {
+#ifdef __GNUC__
+  return WORD_BITS - 1 - __builtin_clzl(word);
+#else
+  unsigned i = 0;
+  for (; word >>= 1;) ++i;
+  return i;
+#endif
+}
+
+/* The bitmap uses the word embedded in the list when one word is enough.
+ * bit_words is the length of an allocated bitmap, which may be longer than
+ * the capacity needs if shrinking it failed.
+ */
+static int alist_realloc_bits(ArrayList *list, size_t cap) {
+  size_t words = WORD_COUNT(cap);
+  int was_small =
+      list->occupied == NULL || list->occupied == &list->small_occupied;
+  size_t old_words = was_small ? 1 : list->bit_words;
+  unsigned long *bits;
+
+  if (list->occupied == NULL) list->small_occupied = 0;
+  if (words <= 1) {
+    if (!was_small) {
+      list->small_occupied = list->occupied[0];
+      blib_free(list->allocator, list->occupied,
+                sizeof(unsigned long) * old_words);
+    }
+    list->occupied = &list->small_occupied;
+    return 0;
+  } else if (was_small) {
+    bits = blib_alloc(list->allocator, sizeof(unsigned long) * words);
+    if (bits == NULL) {
+      last_status = BLIB_ALLOC_FAIL;
+      return -1;
+    }
+    bits[0] = list->small_occupied;
+    memset(bits + 1, 0, sizeof(unsigned long) * (words - 1));
+  } else if (words != old_words) {
+    bits = blib_realloc(list->allocator, list->occupied,
+                        sizeof(unsigned long) * old_words,
+                        sizeof(unsigned long) * words);
+    if (bits == NULL) {
+      /* a larger bitmap than needed is harmless */
+      if (words < old_words) return 0;
+      last_status = BLIB_ALLOC_FAIL;
+      return -1;
+    }
+    if (words > old_words)
+      memset(bits + old_words, 0, sizeof(unsigned long) * (words - old_words));
+  } else {
+    return 0;
+  }
+  list->occupied = bits;
+  list->bit_words = words;
+  return 0;
+}
+
+/* updates the bitmap and count after `element` is stored at index */
+static void alist_mark(ArrayList *list, size_t index, const void *element) {
+  unsigned long *word = list->occupied + index / WORD_BITS;
+  unsigned long bit = 1UL << index % WORD_BITS;
+  if (element && !(*word & bit)) {
+    *word |= bit;
+    ++list->count;
+  } else if (!element && (*word & bit)) {
+    *word &= ~bit;
+    --list->count;
+  }
+}
+
+static void alist_rebuild_bits(ArrayList *list) {
+  size_t i;
+  memset(list->occupied, 0, sizeof(unsigned long) * WORD_COUNT(list->size));
+  list->count = 0;
+  for (i = 0; i < list->size; ++i) alist_mark(list, i, list->data[i]);
+}
+
+/* re-marks [start, end) after the slots there were moved around */
+static void alist_remark(ArrayList *list, size_t start, size_t end) {
+  for (; start < end; ++start) alist_mark(list, start, list->data[start]);
+}
+
+#ifdef BLIB_ALIST_MREMAP
+static size_t map_length(size_t cap) {
+  size_t page = sysconf(_SC_PAGESIZE);
+  return (sizeof(void *) * cap + page - 1) / page * page;
+}
+#endif
+
+static void alist_release_data(ArrayList *list, void **data, size_t cap,
+                               int mapped) {
+  if (data == list->small) return;
+#ifdef BLIB_ALIST_MREMAP
+  if (mapped) {
+    munmap(data, map_length(cap));
+    return;
+  }
+#else
+  (void)mapped;
+#endif
+  blib_free(list->allocator, data, sizeof(void *) * cap);
+}
+
+/* Changes the capacity of the array, copying the first list->size elements.
+ * Capacities of up to BLIB_ALIST_SMALL_CAP use the buffer inside the list
+ * itself. On failure, the list is left unchanged.
+ */
+static int alist_realloc(ArrayList *list, size_t cap) {
+  void **new_data;
+  int mapped = 0, copy = 1;
+  /* grow the bitmap first, so that a failure leaves the data untouched */
+  if (cap > list->cap && alist_realloc_bits(list, cap)) return -1;
+
+  if (cap <= BLIB_ALIST_SMALL_CAP) {
+    new_data = list->small;
+#ifdef BLIB_ALIST_MREMAP
+  } else if (!list->allocator &&
+             sizeof(void *) * cap >= BLIB_ALIST_MMAP_THRESHOLD) {
+    mapped = 1;
+    if (list->mapped) {
+      new_data = mremap(list->data, map_length(list->cap), map_length(cap),
+                        MREMAP_MAYMOVE);
+      copy = 0;
+    } else {
+      new_data = mmap(NULL, map_length(cap), PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (new_data == MAP_FAILED) new_data = NULL;
+#endif
+  } else if (list->data && list->data != list->small && !list->mapped) {
+    new_data = blib_realloc(list->allocator, list->data,
+                            sizeof(void *) * list->cap, sizeof(void *) * cap);
+    copy = 0;
+  } else {
+    new_data = blib_alloc(list->allocator, sizeof(void *) * cap);
+  }
+
+  if (new_data == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  } else if (copy && new_data != list->data) {
+    if (list->data) {
+      memcpy(new_data, list->data,
+             sizeof(void *) * (list->size < cap ? list->size : cap));
+      alist_release_data(list, list->data, list->cap, list->mapped);
+    }
+  }
+  if (cap < list->cap) alist_realloc_bits(list, cap);
+  list->data = new_data;
+  list->cap = cap;
+  list->mapped = mapped;
+  return 0;
+}
+
+static void alist_release(ArrayList *list) {
+  alist_release_data(list, list->data, list->cap, list->mapped);
+  if (list->occupied != &list->small_occupied)
+    blib_free(list->allocator, list->occupied,
+              sizeof(unsigned long) * list->bit_words);
+}
+
+/* capacity that the growth policy would give a list that must hold `needed`
+ * elements
+ */
+static size_t alist_next_cap(const ArrayList *list, size_t needed) {
+  size_t cap = list->cap ? list->cap : 1;
+  unsigned growth =
+      list->growth_factor ? list->growth_factor : BLIB_ALIST_DEFAULT_GROWTH;
+  while (cap < needed) {
+    if (list->growth_chunk && cap >= list->growth_threshold) {
+      size_t chunk = list->growth_chunk;
+      return cap + (needed - cap + chunk - 1) / chunk * chunk;
+    } else {
+      size_t next = cap / 100 * growth + cap % 100 * growth / 100;
+      cap = next > cap ? next : cap + 1;
+    }
+  }
+  return cap;
+}
+
 static int alist_valid(const ArrayList *list) {
   if (list == NULL || list->cap == 0) {
     last_status = BLIB_INVALID_STRUCT;
     return 0;
-  } else if (list->data == NULL) {
+  } else if (list->data == NULL || list->occupied == NULL) {
     last_status = BLIB_UNINITIALIZED_ARG;
     return 0;
   } else {
@@ -21,21 +372,45 @@ static int alist_valid(const ArrayList *list) {
   }
 }
 
+/* destroys and clears the elements in [start, end) */
+static void alist_destroy_range(ArrayList *list, size_t start, size_t end,
+                                BlibDestroyer destroy) {
+  size_t i;
+  for (i = start; i < end; ++i) {
+    if (list->data[i]) {
+      if (destroy) DESTROY_DATA(destroy, list->data[i]);
+      list->data[i] = NULL;
+      alist_mark(list, i, NULL);
+    }
+  }
+}
+
 /* external functions */
 int alist_init(ArrayList *list, size_t size) {
+  return alist_init_alloc(list, size, NULL);
+}
+
+int alist_init_alloc(ArrayList *list, size_t size,
+                     const BlibAllocator *allocator) {
   if (list == NULL) {
     last_status = BLIB_INVALID_STRUCT;
     return -1;
   }
 
+  list->data = NULL;
+  list->occupied = NULL;
+  list->size = 0;
+  list->count = 0;
+  list->cap = 0;
+  list->growth_factor = BLIB_ALIST_DEFAULT_GROWTH;
+  list->growth_threshold = 0;
+  list->growth_chunk = 0;
+  list->compact_threshold = 0;
+  list->mapped = 0;
+  list->bit_words = 0;
+  list->allocator = allocator;
+  if (alist_realloc(list, alist_next_cap(list, size))) return -1;
   list->size = size;
-  list->cap = 1;
-  while (list->cap < list->size) list->cap <<= 1;
-  list->data = malloc(sizeof(void *) * list->cap);
-  if (list->data == NULL) {
-    last_status = BLIB_ALLOC_FAIL;
-    return -1;
-  }
   memset(list->data, 0, sizeof(void *) * list->size);
   last_status = BLIB_SUCCESS;
   return 0;
@@ -47,11 +422,8 @@ int alist_destroy(ArrayList *list, BlibDestroyer destroy) {
   else if (!alist_valid(list))
     return -1;
 
-  size_t i;
-  for (i = 0; i < list->size; ++i)
-    if (destroy && list->data[i]) DESTROY_DATA(destroy, list->data[i]);
-
-  free(list->data);
+  if (destroy) alist_destroy_range(list, 0, list->size, destroy);
+  alist_release(list);
   /* paranoid free */
   memset(list, 0, sizeof(ArrayList));
   return 0;
@@ -59,15 +431,7 @@ int alist_destroy(ArrayList *list, BlibDestroyer destroy) {
 
 int alist_clear(ArrayList *list, BlibDestroyer destroy) {
   if (!alist_valid(list)) return -1;
-
-  size_t i;
-  for (i = 0; i < list->size; ++i) {
-    if (list->data[i]) {
-      if (destroy) DESTROY_DATA(destroy, list->data[i]);
-      list->data[i] = NULL;
-    }
-  }
-
+  alist_destroy_range(list, 0, list->size, destroy);
   return 0;
 }
 
@@ -92,14 +456,9 @@ int alist_insert(ArrayList *list, void *element, size_t index,
     last_status = BLIB_OUT_OF_BOUNDS;
     return -1;
   } else if (index == list->size) {
-    if (index == list->cap) {
-      void **new_data = realloc(list->data, sizeof(void *) * (list->cap <<= 1));
-      if (new_data == NULL) {
-        last_status = BLIB_ALLOC_FAIL;
-        return -1;
-      }
-      list->data = new_data;
-    }
+    if (index == list->cap &&
+        alist_realloc(list, alist_next_cap(list, list->cap + 1)))
+      return -1;
     ++list->size;
   } else if (list->data[index] && destroy) {
     /* don't call destroy on list->data[list->size]; it is garbage */
@@ -107,6 +466,7 @@ int alist_insert(ArrayList *list, void *element, size_t index,
   }
 
   list->data[index] = element;
+  alist_mark(list, index, element);
   return 0;
 }
 
@@ -118,26 +478,21 @@ int alist_delete(ArrayList *list, size_t index, BlibDestroyer destroy) {
     return -1;
   }
 
-  if (list->data[index]) {
-    if (destroy) DESTROY_DATA(destroy, list->data[index]);
-    list->data[index] = NULL;
-  }
-
+  alist_destroy_range(list, index, index + 1, destroy);
+  if (list->compact_threshold &&
+      (list->size - list->count) * 100 > list->size * list->compact_threshold)
+    return alist_compact(list, NULL);
   return 0;
 }
 
 int alist_push(ArrayList *list, void *data) {
   if (!alist_valid(list)) return -1;
 
-  if (list->size == list->cap) {
-    void **new_data = realloc(list->data, sizeof(void *) * (list->cap <<= 1));
-    if (new_data == NULL) {
-      last_status = BLIB_ALLOC_FAIL;
-      return -1;
-    }
-    list->data = new_data;
-  }
-  list->data[list->size++] = data;
+  if (list->size == list->cap &&
+      alist_realloc(list, alist_next_cap(list, list->cap + 1)))
+    return -1;
+  list->data[list->size] = data;
+  alist_mark(list, list->size++, data);
   return 0;
 }
 
@@ -148,9 +503,8 @@ int alist_pop(ArrayList *list, BlibDestroyer destroy) {
     last_status = BLIB_EMPTY;
     return -1;
   } else {
+    alist_destroy_range(list, list->size - 1, list->size, destroy);
     --list->size;
-    if (list->data[list->size] && destroy)
-      DESTROY_DATA(destroy, list->data[list->size]);
     return 0;
   }
 }
@@ -168,16 +522,22 @@ void *alist_peek(ArrayList *list) {
   }
 }
 
+/* if compare is NULL, elements are compared by address */
 size_t alist_find(const ArrayList *list, void *target, BlibComparator compare) {
   if (!alist_valid(list)) {
     return -1;
+  } else if (!compare) {
+    size_t i = target ? scan_first(list->data, list->size, target) : list->size;
+    if (i == list->size) last_status = W_BLIB_NOT_FOUND;
+    return i;
   }
 
-  size_t i;
-  for (i = 0; i < list->size; ++i) {
-    void *element = list->data[i];
-    if (element && compare(target, element)) {
-      return i;
+  size_t w;
+  for (w = 0; w < WORD_COUNT(list->size); ++w) {
+    unsigned long word = list->occupied[w];
+    for (; word; word &= word - 1) {
+      size_t i = w * WORD_BITS + bit_first(word);
+      if (compare(target, list->data[i])) return i;
     }
   }
 
@@ -189,13 +549,20 @@ size_t alist_rfind(const ArrayList *list, void *target,
                    BlibComparator compare) {
   if (!alist_valid(list)) {
     return -1;
+  } else if (!compare) {
+    size_t i = target ? scan_last(list->data, list->size, target) : list->size;
+    if (i == list->size) last_status = W_BLIB_NOT_FOUND;
+    return i;
   }
 
-  size_t i;
-  for (i = 1; i <= list->size; ++i) {
-    void *element = list->data[list->size - i];
-    if (element && compare(target, element)) {
-      return list->size - i;
+  size_t w;
+  for (w = WORD_COUNT(list->size); w > 0; --w) {
+    unsigned long word = list->occupied[w - 1];
+    while (word) {
+      unsigned bit = bit_last(word);
+      size_t i = (w - 1) * WORD_BITS + bit;
+      if (compare(target, list->data[i])) return i;
+      word &= ~(1UL << bit);
     }
   }
 
@@ -203,6 +570,7 @@ size_t alist_rfind(const ArrayList *list, void *target,
   return list->size;
 }
 
+/* empty slots are skipped a word of the bitmap at a time */
 void alist_foreach(ArrayList *list, void (*fn)(void *)) {
   if (!alist_valid(list)) {
     return;
@@ -211,10 +579,11 @@ void alist_foreach(ArrayList *list, void (*fn)(void *)) {
     return;
   }
 
-  size_t i;
-  for (i = 0; i < list->size; ++i) {
-    void *element = alist_get(list, i);
-    if (element) fn(element);
+  size_t w;
+  for (w = 0; w < WORD_COUNT(list->size); ++w) {
+    unsigned long word = list->occupied[w];
+    for (; word; word &= word - 1)
+      fn(list->data[w * WORD_BITS + bit_first(word)]);
   }
 }
 
@@ -235,6 +604,7 @@ void alist_ssort(ArrayList *list, BlibComparator greater_equal) {
     list->data[min_index] = list->data[i];
     list->data[i] = temp;
   }
+  alist_rebuild_bits(list);
 }
 
 int alist_resize(ArrayList *list, size_t size, BlibDestroyer destroy) {
@@ -243,44 +613,193 @@ int alist_resize(ArrayList *list, size_t size, BlibDestroyer destroy) {
   }
 
   if (size > list->size) {
-    if (size > list->cap) {
-      while (size > list->cap) list->cap <<= 1;
-      void **new_data = realloc(list->data, sizeof(void *) * list->cap);
-      if (new_data == NULL) {
-        last_status = BLIB_ALLOC_FAIL;
-        return -1;
-      }
-      list->data = new_data;
-    }
+    if (size > list->cap && alist_realloc(list, alist_next_cap(list, size)))
+      return -1;
     void **first_new = list->data + list->size;
     size_t size_new = size - list->size;
     memset(first_new, 0, sizeof(void *) * size_new);
   } else {
-    size_t i;
-    for (i = size; i < list->size; ++i)
-      if (list->data[i] && destroy) DESTROY_DATA(destroy, list->data[i]);
+    alist_destroy_range(list, size, list->size, destroy);
 
     if (list->cap >> 1 > size) {
-      while (list->cap >> 1 > size) list->cap >>= 1;
-      void **new_data = realloc(list->data, sizeof(void *) * list->cap);
-      if (new_data == NULL) {
-        last_status = BLIB_ALLOC_FAIL;
-        return -1;
-      }
-      list->data = new_data;
+      size_t cap = list->cap;
+      while (cap >> 1 > size) cap >>= 1;
+      if (alist_realloc(list, cap)) return -1;
     }
   }
   list->size = size;
   return 0;
 }
 
+/* Inserts `count` elements before index, shifting the rest of the list up.
+ * Unlike alist_insert, nothing is overwritten. `elements` must not point into
+ * the list itself, since the list may be reallocated.
+ */
+int alist_insert_range(ArrayList *list, size_t index, void *const *elements,
+                       size_t count) {
+  if (!alist_valid(list)) {
+    return -1;
+  } else if (index > list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  } else if (count > (size_t)-1 / sizeof(void *) - list->size) {
+    last_status = BLIB_INVALID_SIZE;
+    return -1;
+  } else if (count == 0) {
+    return 0;
+  } else if (elements == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+
+  size_t size = list->size + count;
+  if (size > list->cap && alist_realloc(list, alist_next_cap(list, size)))
+    return -1;
+  memmove(list->data + index + count, list->data + index,
+          sizeof(void *) * (list->size - index));
+  memcpy(list->data + index, elements, sizeof(void *) * count);
+  list->size = size;
+  alist_remark(list, index, size);
+  return 0;
+}
+
+int alist_append_range(ArrayList *list, void *const *elements, size_t count) {
+  if (!alist_valid(list)) return -1;
+  return alist_insert_range(list, list->size, elements, count);
+}
+
+/* removes [start, end), shifting the rest of the list down */
+int alist_erase_range(ArrayList *list, size_t start, size_t end,
+                      BlibDestroyer destroy) {
+  if (!alist_valid(list)) {
+    return -1;
+  } else if (start > end || end > list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+
+  size_t size = list->size - (end - start);
+  alist_destroy_range(list, start, end, destroy);
+  memmove(list->data + start, list->data + end,
+          sizeof(void *) * (list->size - end));
+  memset(list->data + size, 0, sizeof(void *) * (end - start));
+  alist_remark(list, start, list->size);
+  list->size = size;
+  return 0;
+}
+
+/* Moves [start, end) of src into dest before index. Nothing is destroyed,
+ * and if dest cannot grow both lists are left unchanged.
+ */
+int alist_splice(ArrayList *dest, size_t index, ArrayList *src, size_t start,
+                 size_t end) {
+  if (!alist_valid(dest) || !alist_valid(src)) {
+    return -1;
+  } else if (dest == src) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  } else if (start > end || end > src->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  } else if (alist_insert_range(dest, index, src->data + start, end - start)) {
+    return -1;
+  }
+  return alist_erase_range(src, start, end, NULL);
+}
+
+/* Moves the elements down over the empty slots, keeping their order, and
+ * shrinks the size to the element count. If remap is not NULL, it must have
+ * room for the old size, and remap[i] is set to the new index of the element
+ * that was at i, or (size_t)-1 if slot i was empty.
+ */
+int alist_compact(ArrayList *list, size_t *remap) {
+  if (!alist_valid(list)) return -1;
+
+  size_t w, words = WORD_COUNT(list->size), j = 0;
+  if (remap) memset(remap, 0xff, sizeof(size_t) * list->size);
+  for (w = 0; w < words; ++w) {
+    unsigned long word = list->occupied[w];
+    for (; word; word &= word - 1) {
+      size_t i = w * WORD_BITS + bit_first(word);
+      if (remap) remap[i] = j;
+      list->data[j++] = list->data[i];
+    }
+  }
+
+  /* the first j slots are now exactly the occupied ones */
+  memset(list->occupied, 0, sizeof(unsigned long) * words);
+  memset(list->occupied, 0xff, sizeof(unsigned long) * (j / WORD_BITS));
+  if (j % WORD_BITS)
+    list->occupied[j / WORD_BITS] = (1UL << j % WORD_BITS) - 1;
+  list->size = j;
+  return 0;
+}
+
+/* compact automatically once more than `percent` percent of the slots are
+ * empty after a deletion; 0 disables automatic compaction
+ */
+int alist_set_compaction(ArrayList *list, unsigned percent) {
+  if (!alist_valid(list)) {
+    return -1;
+  } else if (percent > 100) {
+    last_status = BLIB_INVALID_SIZE;
+    return -1;
+  }
+  list->compact_threshold = percent;
+  return 0;
+}
+
 size_t alist_count(ArrayList *list) {
   if (!alist_valid(list)) return -1;
+  return list->count;
+}
 
-  size_t i, count = 0;
-  for (i = 0; i < list->size; ++i)
-    if (list->data[i]) ++count;
-  return count;
+size_t alist_first_index(const ArrayList *list) {
+  if (!alist_valid(list)) return -1;
+  size_t w;
+  for (w = 0; w < WORD_COUNT(list->size); ++w)
+    if (list->occupied[w]) return w * WORD_BITS + bit_first(list->occupied[w]);
+  last_status = W_BLIB_NOT_FOUND;
+  return list->size;
+}
+
+size_t alist_last_index(const ArrayList *list) {
+  if (!alist_valid(list)) return -1;
+  size_t w;
+  for (w = WORD_COUNT(list->size); w > 0; --w)
+    if (list->occupied[w - 1])
+      return (w - 1) * WORD_BITS + bit_last(list->occupied[w - 1]);
+  last_status = W_BLIB_NOT_FOUND;
+  return list->size;
+}
+
+int alist_reserve(ArrayList *list, size_t cap) {
+  if (!alist_valid(list)) return -1;
+  return cap > list->cap ? alist_realloc(list, cap) : 0;
+}
+
+int alist_shrink_to_fit(ArrayList *list) {
+  if (!alist_valid(list)) return -1;
+  size_t cap = list->size ? list->size : 1;
+  return cap < list->cap ? alist_realloc(list, cap) : 0;
+}
+
+/* `factor` is the percentage of the current capacity that a full list grows
+ * to, so 200 doubles it. Once the capacity reaches `threshold`, the list
+ * instead grows by multiples of `chunk` elements; a chunk of 0 disables this.
+ */
+int alist_set_growth(ArrayList *list, unsigned factor, size_t threshold,
+                     size_t chunk) {
+  if (!alist_valid(list)) {
+    return -1;
+  } else if (factor <= 100) {
+    last_status = BLIB_INVALID_SIZE;
+    return -1;
+  }
+  list->growth_factor = factor;
+  list->growth_threshold = threshold;
+  list->growth_chunk = chunk;
+  return 0;
 }
 
 size_t alist_size(const ArrayList *list) { return list->size; }
@@ -4,16 +4,42 @@
 
 #include "badlib.h"
 
+/* number of elements that fit in the buffer embedded in the list */
+#ifndef BLIB_ALIST_SMALL_CAP
+#define BLIB_ALIST_SMALL_CAP 8
+#endif
+
 #define BLIB_ALIST_EMPTY \
-  { NULL, 0, 0, 0, NULL, NULL, BLIB_SUCCESS }
+  { NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, { NULL }, 0, 0, NULL }
 
+/* Lists whose capacity is at most BLIB_ALIST_SMALL_CAP keep their elements in
+ * `small` instead of a separate allocation, so `data` may point into the list
+ * itself. Such a list must not be copied or moved while it is in use.
+ *
+ * `occupied` is a bitmap with a bit set for each non-NULL slot, and `count` is
+ * the number of bits set. Both are kept up to date by the functions below, so
+ * elements must not be stored by writing to `data` directly.
+ */
 typedef struct alist {
   void **data;
+  unsigned long *occupied;
   size_t size;
+  size_t count;
   size_t cap;
+  unsigned growth_factor;
+  size_t growth_threshold;
+  size_t growth_chunk;
+  unsigned compact_threshold;
+  int mapped;
+  void *small[BLIB_ALIST_SMALL_CAP];
+  unsigned long small_occupied;
+  size_t bit_words;
+  const BlibAllocator *allocator;
 } ArrayList;
 
 int alist_init(ArrayList *list, size_t size);
+int alist_init_alloc(ArrayList *list, size_t size,
+                     const BlibAllocator *allocator);
 int alist_destroy(ArrayList *list, BlibDestroyer destroyer);
 int alist_clear(ArrayList *list, BlibDestroyer destroy);
 
@@ -31,7 +57,22 @@ size_t alist_rfind(const ArrayList *list, void *target, BlibComparator compare);
 void alist_foreach(ArrayList *list, void (*fn)(void *));
 void alist_ssort(ArrayList *list, BlibComparator greater_equal);
 int alist_resize(ArrayList *list, size_t size, BlibDestroyer destroyer);
+int alist_reserve(ArrayList *list, size_t cap);
+int alist_shrink_to_fit(ArrayList *list);
+int alist_set_growth(ArrayList *list, unsigned factor, size_t threshold,
+                     size_t chunk);
+int alist_insert_range(ArrayList *list, size_t index, void *const *elements,
+                       size_t count);
+int alist_append_range(ArrayList *list, void *const *elements, size_t count);
+int alist_erase_range(ArrayList *list, size_t start, size_t end,
+                      BlibDestroyer destroyer);
+int alist_splice(ArrayList *dest, size_t index, ArrayList *src, size_t start,
+                 size_t end);
+int alist_compact(ArrayList *list, size_t *remap);
+int alist_set_compaction(ArrayList *list, unsigned percent);
 size_t alist_count(ArrayList *list);
+size_t alist_first_index(const ArrayList *list);
+size_t alist_last_index(const ArrayList *list);
 
 size_t alist_size(const ArrayList *list);
 size_t alist_cap(const ArrayList *list);
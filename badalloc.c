@@ -0,0 +1,341 @@
+#include "badalloc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "badlib.h"
+
+/* the strictest alignment of any basic type, which malloc also guarantees */
+typedef union max_align {
+  long l;
+  double d;
+  long double ld;
+  void *p;
+  void (*f)(void);
+} MaxAlign;
+
+#define ALIGN sizeof(MaxAlign)
+#define ROUND(SIZE) (((SIZE) + ALIGN - 1) / ALIGN * ALIGN)
+/* the usable bytes of a block start after its padded header */
+#define BLOCK_DATA(BLOCK) ((char *)(BLOCK) + ROUND(sizeof(ArenaBlock)))
+
+static BlibError last_status = BLIB_SUCCESS;
+
+void *blib_alloc(const BlibAllocator *allocator, size_t size) {
+  if (!allocator) return malloc(size);
+  return (allocator->allocate)(allocator->context, size);
+}
+
+void *blib_calloc(const BlibAllocator *allocator, size_t size) {
+  if (!allocator) return calloc(1, size);
+  void *ptr = (allocator->allocate)(allocator->context, size);
+  if (ptr) memset(ptr, 0, size);
+  return ptr;
+}
+
+void *blib_realloc(const BlibAllocator *allocator, void *ptr, size_t old_size,
+                   size_t new_size) {
+  if (!allocator) return realloc(ptr, new_size);
+  if (!ptr) return (allocator->allocate)(allocator->context, new_size);
+  return (allocator->reallocate)(allocator->context, ptr, old_size, new_size);
+}
+
+void blib_free(const BlibAllocator *allocator, void *ptr, size_t size) {
+  if (!allocator) {
+    free(ptr);
+  } else if (ptr) {
+    (allocator->release)(allocator->context, ptr, size);
+  }
+}
+
+static void *malloc_allocate(void *context, size_t size) {
+  (void)context;
+  return malloc(size);
+}
+
+static void *malloc_reallocate(void *context, void *ptr, size_t old_size,
+                               size_t new_size) {
+  (void)context;
+  (void)old_size;
+  return realloc(ptr, new_size);
+}
+
+static void malloc_release(void *context, void *ptr, size_t size) {
+  (void)context;
+  (void)size;
+  free(ptr);
+}
+
+const BlibAllocator blib_malloc_allocator = {malloc_allocate, malloc_reallocate,
+                                             malloc_release, NULL};
+
+/* arena */
+
+static int arena_valid(const Arena *arena) {
+  if (!arena || arena->allocator.context != arena) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  }
+  return 1;
+}
+
+/* Starts a new block for an allocation of size bytes. One too large for a
+ * regular block gets a block of its own behind the newest, so the space left
+ * in the newest is still used.
+ */
+static void *arena_grow(Arena *arena, size_t size) {
+  int own = size > arena->block_size / 4;
+  size_t capacity = own ? size : arena->block_size;
+  size_t block_size = ROUND(sizeof(ArenaBlock)) + capacity;
+  ArenaBlock *block = blib_alloc(arena->parent, block_size);
+  if (!block) return NULL;
+  block->size = block_size;
+
+  if (own && arena->blocks) {
+    block->next = arena->blocks->next;
+    arena->blocks->next = block;
+    return BLOCK_DATA(block);
+  }
+
+  block->next = arena->blocks;
+  arena->blocks = block;
+  arena->cursor = BLOCK_DATA(block) + size;
+  arena->limit = BLOCK_DATA(block) + capacity;
+  arena->last = BLOCK_DATA(block);
+  return arena->last;
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+  size = ROUND(size ? size : 1);
+  if ((size_t)(arena->limit - arena->cursor) < size)
+    return arena_grow(arena, size);
+
+  arena->last = arena->cursor;
+  arena->cursor += size;
+  return arena->last;
+}
+
+static void *arena_allocate(void *context, size_t size) {
+  return arena_alloc(context, size);
+}
+
+static void *arena_reallocate(void *context, void *ptr, size_t old_size,
+                              size_t new_size) {
+  Arena *arena = context;
+  size_t rounded = ROUND(new_size ? new_size : 1);
+
+  /* the latest allocation resizes in place while the block has room */
+  if (ptr == arena->last && arena->cursor != arena->last &&
+      (size_t)(arena->limit - arena->last) >= rounded) {
+    arena->cursor = arena->last + rounded;
+    return ptr;
+  }
+  if (new_size <= old_size) return ptr;
+
+  void *fresh = arena_alloc(arena, new_size);
+  if (fresh) memcpy(fresh, ptr, old_size);
+  return fresh;
+}
+
+static void arena_release(void *context, void *ptr, size_t size) {
+  Arena *arena = context;
+  (void)size;
+  /* only the latest allocation can be taken back */
+  if (ptr == arena->last && arena->cursor != arena->last)
+    arena->cursor = arena->last;
+}
+
+int arena_init(Arena *arena, size_t block_size) {
+  return arena_init_alloc(arena, block_size, NULL);
+}
+
+int arena_init_alloc(Arena *arena, size_t block_size,
+                     const BlibAllocator *parent) {
+  if (!arena) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+
+  arena->allocator.allocate = arena_allocate;
+  arena->allocator.reallocate = arena_reallocate;
+  arena->allocator.release = arena_release;
+  arena->allocator.context = arena;
+  arena->parent = parent;
+  arena->blocks = NULL;
+  arena->cursor = arena->limit = arena->last = NULL;
+  arena->block_size = ROUND(block_size ? block_size : BLIB_ARENA_BLOCK);
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int arena_destroy(Arena *arena) {
+  if (!arena_valid(arena)) return -1;
+
+  while (arena->blocks) {
+    ArenaBlock *next = arena->blocks->next;
+    blib_free(arena->parent, arena->blocks, arena->blocks->size);
+    arena->blocks = next;
+  }
+  arena->cursor = arena->limit = arena->last = NULL;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int arena_reset(Arena *arena) {
+  if (!arena_valid(arena)) return -1;
+  if (!arena->blocks) {
+    last_status = BLIB_SUCCESS;
+    return 0;
+  }
+
+  /* keep the newest block for the next round */
+  ArenaBlock *keep = arena->blocks;
+  while (keep->next) {
+    ArenaBlock *next = keep->next->next;
+    blib_free(arena->parent, keep->next, keep->next->size);
+    keep->next = next;
+  }
+  arena->cursor = arena->last = BLOCK_DATA(keep);
+  arena->limit = (char *)keep + keep->size;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+const BlibAllocator *arena_allocator(Arena *arena) {
+  if (!arena_valid(arena)) return NULL;
+  return &arena->allocator;
+}
+
+int arena_status(const Arena *arena) {
+  (void)arena_valid(arena);
+  return last_status;
+}
+
+/* pool */
+
+static int pool_valid(const Pool *pool) {
+  if (!pool || pool->allocator.context != pool) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  }
+  return 1;
+}
+
+static unsigned size_class(size_t size) {
+  if (size <= 128) return size ? (unsigned)((size + 15) >> 4) - 1 : 0;
+
+  unsigned index = 8;
+  size_t bound = 256;
+  while (bound < size) {
+    bound <<= 1;
+    ++index;
+  }
+  return index;
+}
+
+static size_t class_size(unsigned index) {
+  return index < 8 ? (size_t)(index + 1) << 4 : (size_t)128 << (index - 7);
+}
+
+/* cuts a new slab into blocks of one class and puts them on its free list */
+static int pool_refill(Pool *pool, unsigned index) {
+  ArenaBlock *slab = blib_alloc(pool->parent, BLIB_POOL_SLAB);
+  if (!slab) return -1;
+  slab->size = BLIB_POOL_SLAB;
+  slab->next = pool->slabs;
+  pool->slabs = slab;
+
+  size_t size = class_size(index);
+  char *block = BLOCK_DATA(slab);
+  char *end = (char *)slab + BLIB_POOL_SLAB;
+  for (; block + size <= end; block += size) {
+    *(void **)block = pool->free_lists[index];
+    pool->free_lists[index] = block;
+  }
+  return 0;
+}
+
+static void *pool_allocate(void *context, size_t size) {
+  Pool *pool = context;
+  if (size > BLIB_POOL_MAX) return blib_alloc(pool->parent, size);
+
+  unsigned index = size_class(size);
+  if (!pool->free_lists[index] && pool_refill(pool, index)) return NULL;
+
+  void *block = pool->free_lists[index];
+  pool->free_lists[index] = *(void **)block;
+  return block;
+}
+
+static void pool_release(void *context, void *ptr, size_t size) {
+  Pool *pool = context;
+  if (size > BLIB_POOL_MAX) {
+    blib_free(pool->parent, ptr, size);
+    return;
+  }
+
+  unsigned index = size_class(size);
+  *(void **)ptr = pool->free_lists[index];
+  pool->free_lists[index] = ptr;
+}
+
+static void *pool_reallocate(void *context, void *ptr, size_t old_size,
+                             size_t new_size) {
+  Pool *pool = context;
+  if (old_size > BLIB_POOL_MAX && new_size > BLIB_POOL_MAX)
+    return blib_realloc(pool->parent, ptr, old_size, new_size);
+  /* a block already big enough for its class is kept */
+  if (old_size <= BLIB_POOL_MAX && new_size <= BLIB_POOL_MAX &&
+      size_class(old_size) == size_class(new_size))
+    return ptr;
+
+  void *fresh = pool_allocate(pool, new_size);
+  if (!fresh) return NULL;
+  memcpy(fresh, ptr, old_size < new_size ? old_size : new_size);
+  pool_release(pool, ptr, old_size);
+  return fresh;
+}
+
+int pool_init(Pool *pool) { return pool_init_alloc(pool, NULL); }
+
+int pool_init_alloc(Pool *pool, const BlibAllocator *parent) {
+  if (!pool) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+
+  pool->allocator.allocate = pool_allocate;
+  pool->allocator.reallocate = pool_reallocate;
+  pool->allocator.release = pool_release;
+  pool->allocator.context = pool;
+  pool->parent = parent;
+  pool->slabs = NULL;
+  unsigned i;
+  for (i = 0; i < BLIB_POOL_CLASSES; ++i) pool->free_lists[i] = NULL;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int pool_destroy(Pool *pool) {
+  if (!pool_valid(pool)) return -1;
+
+  while (pool->slabs) {
+    ArenaBlock *next = pool->slabs->next;
+    blib_free(pool->parent, pool->slabs, BLIB_POOL_SLAB);
+    pool->slabs = next;
+  }
+  unsigned i;
+  for (i = 0; i < BLIB_POOL_CLASSES; ++i) pool->free_lists[i] = NULL;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+const BlibAllocator *pool_allocator(Pool *pool) {
+  if (!pool_valid(pool)) return NULL;
+  return &pool->allocator;
+}
+
+int pool_status(const Pool *pool) {
+  (void)pool_valid(pool);
+  return last_status;
+}
@@ -0,0 +1,87 @@
+#ifndef __BADALLOC_H__
+#define __BADALLOC_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+/* bytes in each block an Arena takes from its parent */
+#ifndef BLIB_ARENA_BLOCK
+#define BLIB_ARENA_BLOCK 65536
+#endif
+
+/* bytes in each slab a Pool carves into blocks of one size class */
+#ifndef BLIB_POOL_SLAB
+#define BLIB_POOL_SLAB 16384
+#endif
+
+/* Pool size classes are multiples of 16 bytes up to 128, then powers of two
+ * up to 2048. Larger requests go straight to the parent.
+ */
+#define BLIB_POOL_CLASSES 12
+#define BLIB_POOL_MAX 2048
+
+/* What the containers call. A NULL allocator means malloc, realloc and free,
+ * so the default costs no indirect calls.
+ */
+void *blib_alloc(const BlibAllocator *allocator, size_t size);
+void *blib_calloc(const BlibAllocator *allocator, size_t size);
+void *blib_realloc(const BlibAllocator *allocator, void *ptr, size_t old_size,
+                   size_t new_size);
+void blib_free(const BlibAllocator *allocator, void *ptr, size_t size);
+
+/* the same malloc allocator as a value, for code that needs a non-NULL one */
+extern const BlibAllocator blib_malloc_allocator;
+
+typedef struct arena_block {
+  struct arena_block *next;
+  size_t size;
+} ArenaBlock;
+
+/* A bump allocator. Allocation advances a cursor through the newest block,
+ * and releasing memory does nothing unless it was the latest allocation,
+ * which can also grow or shrink in place. Everything is given back at once by
+ * arena_reset or arena_destroy, so containers built on an arena need not be
+ * destroyed one by one; their destroyers are then never run.
+ *
+ * The allocator refers to the arena itself, so an Arena must not be copied
+ * or moved while in use.
+ */
+typedef struct arena {
+  BlibAllocator allocator;
+  const BlibAllocator *parent;
+  ArenaBlock *blocks;
+  char *cursor;
+  char *limit;
+  char *last;
+  size_t block_size;
+} Arena;
+
+int arena_init(Arena *arena, size_t block_size);
+int arena_init_alloc(Arena *arena, size_t block_size,
+                     const BlibAllocator *parent);
+int arena_destroy(Arena *arena);
+int arena_reset(Arena *arena);
+void *arena_alloc(Arena *arena, size_t size);
+const BlibAllocator *arena_allocator(Arena *arena);
+int arena_status(const Arena *arena);
+
+/* A size-class allocator. Each class keeps a free list of equal blocks cut
+ * from slabs, so nodes freed by one container are reused by the next without
+ * going back to malloc, and memory does not fragment into odd-sized holes.
+ * Slabs are returned to the parent only by pool_destroy.
+ *
+ * Like an Arena, a Pool must not be copied or moved while in use.
+ */
+typedef struct pool {
+  BlibAllocator allocator;
+  const BlibAllocator *parent;
+  void *free_lists[BLIB_POOL_CLASSES];
+  ArenaBlock *slabs;
+} Pool;
+
+int pool_init(Pool *pool);
+int pool_init_alloc(Pool *pool, const BlibAllocator *parent);
+int pool_destroy(Pool *pool);
+const BlibAllocator *pool_allocator(Pool *pool);
+int pool_status(const Pool *pool);
+#endif
@@ -0,0 +1,724 @@
+#include "badart.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static BlibError last_status = BLIB_SUCCESS;
+
+enum art_type { ART_NODE4 = 1, ART_NODE16, ART_NODE48, ART_NODE256 };
+
+#define IS_LEAF(NODE) (((uintptr_t)(NODE)) & 1)
+#define AS_LEAF(NODE) ((ArtLeaf *)((uintptr_t)(NODE) & ~(uintptr_t)1))
+#define TAG_LEAF(LEAF) ((ArtNode *)((uintptr_t)(LEAF) | 1))
+#define LEAF_KEY(LEAF) ((const unsigned char *)((LEAF) + 1))
+
+#define N4(NODE) ((ArtNode4 *)(NODE))
+#define N16(NODE) ((ArtNode16 *)(NODE))
+#define N48(NODE) ((ArtNode48 *)(NODE))
+#define N256(NODE) ((ArtNode256 *)(NODE))
+
+#define MIN(A, B) ((A) < (B) ? (A) : (B))
+
+static const size_t node_sizes[] = {0, sizeof(ArtNode4), sizeof(ArtNode16),
+                                    sizeof(ArtNode48), sizeof(ArtNode256)};
+
+/* internal functions */
+static int art_valid(const ArtTree *tree) {
+  if (tree == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  }
+  return 1;
+}
+
+static ArtLeaf *leaf_new(const ArtTree *tree, const unsigned char *key,
+                         size_t key_size, void *value) {
+  ArtLeaf *leaf = blib_alloc(tree->allocator, sizeof(ArtLeaf) + key_size);
+  if (leaf == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return NULL;
+  }
+  leaf->value = value;
+  leaf->key_size = key_size;
+  memcpy(leaf + 1, key, key_size);
+  return leaf;
+}
+
+static void leaf_free(const ArtTree *tree, ArtLeaf *leaf) {
+  blib_free(tree->allocator, leaf, sizeof(ArtLeaf) + leaf->key_size);
+}
+
+static int leaf_matches(const ArtLeaf *leaf, const unsigned char *key,
+                        size_t key_size) {
+  return leaf->key_size == key_size && !memcmp(LEAF_KEY(leaf), key, key_size);
+}
+
+/* whether the leaf's key is a prefix of key */
+static int leaf_prefixes(const ArtLeaf *leaf, const unsigned char *key,
+                         size_t key_size) {
+  return leaf->key_size <= key_size &&
+         !memcmp(LEAF_KEY(leaf), key, leaf->key_size);
+}
+
+static ArtNode *node_new(const ArtTree *tree, unsigned char type) {
+  ArtNode *node = blib_calloc(tree->allocator, node_sizes[type]);
+  if (node == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return NULL;
+  }
+  node->type = type;
+  return node;
+}
+
+static void node_free(const ArtTree *tree, ArtNode *node) {
+  blib_free(tree->allocator, node, node_sizes[node->type]);
+}
+
+static void copy_header(ArtNode *dest, const ArtNode *src) {
+  dest->count = src->count;
+  dest->prefix_len = src->prefix_len;
+  dest->leaf = src->leaf;
+  memcpy(dest->partial, src->partial, MIN(src->prefix_len, BLIB_ART_PREFIX));
+}
+
+static ArtNode **find_child(ArtNode *node, unsigned char byte) {
+  unsigned i;
+  switch (node->type) {
+    case ART_NODE4:
+      for (i = 0; i < node->count; ++i)
+        if (N4(node)->keys[i] == byte) return N4(node)->children + i;
+      return NULL;
+    case ART_NODE16: {
+#ifdef __SSE2__
+      /* compares all sixteen key bytes at once */
+      __m128i keys = _mm_loadu_si128((const __m128i *)N16(node)->keys);
+      __m128i match = _mm_cmpeq_epi8(keys, _mm_set1_epi8((char)byte));
+      unsigned bits = (unsigned)_mm_movemask_epi8(match) &
+                      ((1u << node->count) - 1);
+      return bits ? N16(node)->children + __builtin_ctz(bits) : NULL;
+#else
+      for (i = 0; i < node->count; ++i)
+        if (N16(node)->keys[i] == byte) return N16(node)->children + i;
+      return NULL;
+#endif
+    }
+    case ART_NODE48:
+      i = N48(node)->index[byte];
+      return i ? N48(node)->children + i - 1 : NULL;
+    default:
+      return N256(node)->children[byte] ? N256(node)->children + byte : NULL;
+  }
+}
+
+/* the first child in byte order, storing its byte in byte if not NULL */
+static ArtNode *first_child(const ArtNode *node, unsigned char *byte) {
+  unsigned i = 0;
+  ArtNode *child;
+  switch (node->type) {
+    case ART_NODE4:
+      child = N4(node)->children[0];
+      i = N4(node)->keys[0];
+      break;
+    case ART_NODE16:
+      child = N16(node)->children[0];
+      i = N16(node)->keys[0];
+      break;
+    case ART_NODE48:
+      while (!N48(node)->index[i]) ++i;
+      child = N48(node)->children[N48(node)->index[i] - 1];
+      break;
+    default:
+      while (!N256(node)->children[i]) ++i;
+      child = N256(node)->children[i];
+  }
+  if (byte) *byte = (unsigned char)i;
+  return child;
+}
+
+/* the leaf with the lowest key under node, whose key spells out the full
+ * compressed path of every node on the way down
+ */
+static const ArtLeaf *minimum(const ArtNode *node) {
+  while (!IS_LEAF(node)) {
+    if (node->leaf) return node->leaf;
+    node = first_child(node, NULL);
+  }
+  return AS_LEAF(node);
+}
+
+/* the number of bytes of node's compressed path matched by key from depth,
+ * checking bytes past the stored partial prefix against a leaf below
+ */
+static size_t prefix_match(const ArtNode *node, const unsigned char *key,
+                           size_t key_size, size_t depth) {
+  size_t i, end = MIN(MIN(node->prefix_len, BLIB_ART_PREFIX), key_size - depth);
+  for (i = 0; i < end; ++i)
+    if (node->partial[i] != key[depth + i]) return i;
+  if (node->prefix_len > BLIB_ART_PREFIX) {
+    const ArtLeaf *leaf = minimum(node);
+    end = MIN(node->prefix_len, key_size - depth);
+    for (; i < end; ++i)
+      if (LEAF_KEY(leaf)[depth + i] != key[depth + i]) return i;
+  }
+  return i;
+}
+
+/* The same check against only the stored partial prefix. Lookups rely on
+ * it and verify the whole key at the leaf instead.
+ */
+static int partial_matches(const ArtNode *node, const unsigned char *key,
+                           size_t key_size, size_t depth) {
+  size_t i, end = MIN(node->prefix_len, BLIB_ART_PREFIX);
+  if (key_size - depth < node->prefix_len) return 0;
+  for (i = 0; i < end; ++i)
+    if (node->partial[i] != key[depth + i]) return 0;
+  return 1;
+}
+
+/* adds child under byte, growing node into the next size up when it is
+ * full; ref is where node is linked from
+ */
+static int add_child(const ArtTree *tree, ArtNode **ref, ArtNode *node,
+                     unsigned char byte, ArtNode *child) {
+  ArtNode *grown;
+  unsigned i;
+  switch (node->type) {
+    case ART_NODE4:
+    case ART_NODE16: {
+      unsigned cap = node->type == ART_NODE4 ? 4 : 16;
+      unsigned char *keys =
+          node->type == ART_NODE4 ? N4(node)->keys : N16(node)->keys;
+      ArtNode **children =
+          node->type == ART_NODE4 ? N4(node)->children : N16(node)->children;
+      if (node->count < cap) {
+        unsigned pos = 0;
+        while (pos < node->count && keys[pos] < byte) ++pos;
+        memmove(keys + pos + 1, keys + pos, node->count - pos);
+        memmove(children + pos + 1, children + pos,
+                sizeof(ArtNode *) * (node->count - pos));
+        keys[pos] = byte;
+        children[pos] = child;
+        ++node->count;
+        return 0;
+      }
+      if (node->type == ART_NODE4) {
+        grown = node_new(tree, ART_NODE16);
+        if (grown == NULL) return -1;
+        memcpy(N16(grown)->keys, keys, 4);
+        memcpy(N16(grown)->children, children, sizeof(ArtNode *) * 4);
+      } else {
+        grown = node_new(tree, ART_NODE48);
+        if (grown == NULL) return -1;
+        for (i = 0; i < 16; ++i) {
+          N48(grown)->children[i] = children[i];
+          N48(grown)->index[keys[i]] = (unsigned char)(i + 1);
+        }
+      }
+      break;
+    }
+    case ART_NODE48:
+      if (node->count < 48) {
+        for (i = 0; N48(node)->children[i]; ++i) continue;
+        N48(node)->children[i] = child;
+        N48(node)->index[byte] = (unsigned char)(i + 1);
+        ++node->count;
+        return 0;
+      }
+      grown = node_new(tree, ART_NODE256);
+      if (grown == NULL) return -1;
+      for (i = 0; i < 256; ++i)
+        if (N48(node)->index[i])
+          N256(grown)->children[i] =
+              N48(node)->children[N48(node)->index[i] - 1];
+      break;
+    default:
+      N256(node)->children[byte] = child;
+      ++node->count;
+      return 0;
+  }
+  copy_header(grown, node);
+  node_free(tree, node);
+  *ref = grown;
+  return add_child(tree, ref, grown, byte, child);
+}
+
+/* replaces node, once it has lost a child or its own leaf, with something
+ * smaller if it can: the leaf it is left with, its only child with the
+ * paths joined, or a smaller node type
+ */
+static void node_shrink(const ArtTree *tree, ArtNode **ref, ArtNode *node) {
+  ArtNode *shrunk;
+  unsigned i, j = 0;
+  if (node->count == 0) {
+    *ref = TAG_LEAF(node->leaf);
+    node_free(tree, node);
+    return;
+  } else if (node->count == 1 && node->leaf == NULL) {
+    unsigned char byte;
+    ArtNode *child = first_child(node, &byte);
+    if (!IS_LEAF(child)) {
+      /* child's path becomes node's path, the byte between them, then its
+       * own path, of which only the first few bytes are stored
+       */
+      size_t len = node->prefix_len;
+      unsigned char partial[BLIB_ART_PREFIX];
+      memcpy(partial, node->partial, MIN(len, BLIB_ART_PREFIX));
+      if (len < BLIB_ART_PREFIX) partial[len++] = byte;
+      if (len < BLIB_ART_PREFIX)
+        memcpy(partial + len, child->partial,
+               MIN(child->prefix_len, BLIB_ART_PREFIX - len));
+      child->prefix_len += node->prefix_len + 1;
+      memcpy(child->partial, partial,
+             MIN(child->prefix_len, BLIB_ART_PREFIX));
+    }
+    *ref = child;
+    node_free(tree, node);
+    return;
+  }
+
+  switch (node->type) {
+    case ART_NODE16:
+      if (node->count > 3) return;
+      shrunk = node_new(tree, ART_NODE4);
+      if (shrunk == NULL) return;
+      memcpy(N4(shrunk)->keys, N16(node)->keys, node->count);
+      memcpy(N4(shrunk)->children, N16(node)->children,
+             sizeof(ArtNode *) * node->count);
+      break;
+    case ART_NODE48:
+      if (node->count > 12) return;
+      shrunk = node_new(tree, ART_NODE16);
+      if (shrunk == NULL) return;
+      for (i = 0; i < 256; ++i) {
+        if (N48(node)->index[i]) {
+          N16(shrunk)->keys[j] = (unsigned char)i;
+          N16(shrunk)->children[j++] =
+              N48(node)->children[N48(node)->index[i] - 1];
+        }
+      }
+      break;
+    case ART_NODE256:
+      if (node->count > 37) return;
+      shrunk = node_new(tree, ART_NODE48);
+      if (shrunk == NULL) return;
+      for (i = 0; i < 256; ++i) {
+        if (N256(node)->children[i]) {
+          N48(shrunk)->children[j] = N256(node)->children[i];
+          N48(shrunk)->index[i] = (unsigned char)++j;
+        }
+      }
+      break;
+    default:
+      return;
+  }
+  copy_header(shrunk, node);
+  node_free(tree, node);
+  *ref = shrunk;
+}
+
+static void remove_child(const ArtTree *tree, ArtNode **ref, ArtNode *node,
+                         unsigned char byte, ArtNode **slot) {
+  switch (node->type) {
+    case ART_NODE4:
+    case ART_NODE16: {
+      unsigned char *keys =
+          node->type == ART_NODE4 ? N4(node)->keys : N16(node)->keys;
+      ArtNode **children =
+          node->type == ART_NODE4 ? N4(node)->children : N16(node)->children;
+      size_t pos = slot - children;
+      memmove(keys + pos, keys + pos + 1, node->count - pos - 1);
+      memmove(children + pos, children + pos + 1,
+              sizeof(ArtNode *) * (node->count - pos - 1));
+      break;
+    }
+    case ART_NODE48:
+      *slot = NULL;
+      N48(node)->index[byte] = 0;
+      break;
+    default:
+      *slot = NULL;
+  }
+  --node->count;
+  node_shrink(tree, ref, node);
+}
+
+static int insert_at(const ArtTree *tree, ArtNode **ref,
+                     const unsigned char *key, size_t key_size, size_t depth,
+                     void *value) {
+  BlibDestroyer destroy = tree->value_destroy;
+  ArtNode *node = *ref, *split;
+  ArtLeaf *leaf;
+  if (node == NULL) {
+    if ((leaf = leaf_new(tree, key, key_size, value)) == NULL) return -1;
+    *ref = TAG_LEAF(leaf);
+    return 0;
+  }
+
+  if (IS_LEAF(node)) {
+    ArtLeaf *old = AS_LEAF(node);
+    if (leaf_matches(old, key, key_size)) {
+      if (destroy && old->value != value) DESTROY_DATA(destroy, old->value);
+      old->value = value;
+      return 1;
+    }
+    /* both leaves go under a new node holding their common path */
+    size_t common = 0, end = MIN(old->key_size, key_size) - depth;
+    while (common < end && LEAF_KEY(old)[depth + common] == key[depth + common])
+      ++common;
+    if ((split = node_new(tree, ART_NODE4)) == NULL) return -1;
+    if ((leaf = leaf_new(tree, key, key_size, value)) == NULL) {
+      node_free(tree, split);
+      return -1;
+    }
+    split->prefix_len = common;
+    memcpy(split->partial, key + depth, MIN(common, BLIB_ART_PREFIX));
+    depth += common;
+    if (old->key_size == depth)
+      split->leaf = old;
+    else
+      add_child(tree, &split, split, LEAF_KEY(old)[depth], node);
+    if (key_size == depth)
+      split->leaf = leaf;
+    else
+      add_child(tree, &split, split, key[depth], TAG_LEAF(leaf));
+    *ref = split;
+    return 0;
+  }
+
+  if (node->prefix_len) {
+    size_t match = prefix_match(node, key, key_size, depth);
+    if (match < node->prefix_len) {
+      /* the key leaves node's path part way: split the path there */
+      if ((split = node_new(tree, ART_NODE4)) == NULL) return -1;
+      if ((leaf = leaf_new(tree, key, key_size, value)) == NULL) {
+        node_free(tree, split);
+        return -1;
+      }
+      split->prefix_len = match;
+      memcpy(split->partial, node->partial, MIN(match, BLIB_ART_PREFIX));
+      if (node->prefix_len <= BLIB_ART_PREFIX) {
+        unsigned char byte = node->partial[match];
+        node->prefix_len -= match + 1;
+        memmove(node->partial, node->partial + match + 1, node->prefix_len);
+        add_child(tree, &split, split, byte, node);
+      } else {
+        const ArtLeaf *below = minimum(node);
+        unsigned char byte = LEAF_KEY(below)[depth + match];
+        node->prefix_len -= match + 1;
+        memcpy(node->partial, LEAF_KEY(below) + depth + match + 1,
+               MIN(node->prefix_len, BLIB_ART_PREFIX));
+        add_child(tree, &split, split, byte, node);
+      }
+      if (key_size == depth + match)
+        split->leaf = leaf;
+      else
+        add_child(tree, &split, split, key[depth + match], TAG_LEAF(leaf));
+      *ref = split;
+      return 0;
+    }
+    depth += node->prefix_len;
+  }
+
+  if (depth == key_size) {
+    if (node->leaf) {
+      if (destroy && node->leaf->value != value)
+        DESTROY_DATA(destroy, node->leaf->value);
+      node->leaf->value = value;
+      return 1;
+    }
+    if ((node->leaf = leaf_new(tree, key, key_size, value)) == NULL) return -1;
+    return 0;
+  }
+
+  ArtNode **child = find_child(node, key[depth]);
+  if (child)
+    return insert_at(tree, child, key, key_size, depth + 1, value);
+  if ((leaf = leaf_new(tree, key, key_size, value)) == NULL) return -1;
+  if (add_child(tree, ref, node, key[depth], TAG_LEAF(leaf))) {
+    leaf_free(tree, leaf);
+    return -1;
+  }
+  return 0;
+}
+
+static ArtLeaf *delete_at(const ArtTree *tree, ArtNode **ref,
+                          const unsigned char *key, size_t key_size,
+                          size_t depth) {
+  ArtNode *node = *ref;
+  ArtLeaf *leaf;
+  if (node == NULL) return NULL;
+  if (IS_LEAF(node)) {
+    leaf = AS_LEAF(node);
+    if (!leaf_matches(leaf, key, key_size)) return NULL;
+    *ref = NULL;
+    return leaf;
+  }
+
+  if (!partial_matches(node, key, key_size, depth)) return NULL;
+  depth += node->prefix_len;
+  if (depth == key_size) {
+    leaf = node->leaf;
+    if (leaf == NULL || !leaf_matches(leaf, key, key_size)) return NULL;
+    node->leaf = NULL;
+    node_shrink(tree, ref, node);
+    return leaf;
+  }
+
+  ArtNode **child = find_child(node, key[depth]);
+  if (child == NULL) return NULL;
+  if (IS_LEAF(*child)) {
+    leaf = AS_LEAF(*child);
+    if (!leaf_matches(leaf, key, key_size)) return NULL;
+    remove_child(tree, ref, node, key[depth], child);
+    return leaf;
+  }
+  return delete_at(tree, child, key, key_size, depth + 1);
+}
+
+static int visit(const ArtNode *node, ArtVisitor fn) {
+  const ArtLeaf *leaf;
+  int stop;
+  unsigned i;
+  if (IS_LEAF(node)) {
+    leaf = AS_LEAF(node);
+    return fn(LEAF_KEY(leaf), leaf->key_size, leaf->value);
+  }
+  if ((leaf = node->leaf) &&
+      (stop = fn(LEAF_KEY(leaf), leaf->key_size, leaf->value)))
+    return stop;
+
+  switch (node->type) {
+    case ART_NODE4:
+      for (i = 0; i < node->count; ++i)
+        if ((stop = visit(N4(node)->children[i], fn))) return stop;
+      break;
+    case ART_NODE16:
+      for (i = 0; i < node->count; ++i)
+        if ((stop = visit(N16(node)->children[i], fn))) return stop;
+      break;
+    case ART_NODE48:
+      for (i = 0; i < 256; ++i)
+        if (N48(node)->index[i] &&
+            (stop = visit(N48(node)->children[N48(node)->index[i] - 1], fn)))
+          return stop;
+      break;
+    default:
+      for (i = 0; i < 256; ++i)
+        if (N256(node)->children[i] &&
+            (stop = visit(N256(node)->children[i], fn)))
+          return stop;
+  }
+  return 0;
+}
+
+static void subtree_free(const ArtTree *tree, ArtNode *node) {
+  BlibDestroyer destroy = tree->value_destroy;
+  unsigned i;
+  if (IS_LEAF(node)) {
+    if (destroy) DESTROY_DATA(destroy, AS_LEAF(node)->value);
+    leaf_free(tree, AS_LEAF(node));
+    return;
+  }
+  if (node->leaf) subtree_free(tree, TAG_LEAF(node->leaf));
+  switch (node->type) {
+    case ART_NODE4:
+      for (i = 0; i < node->count; ++i)
+        subtree_free(tree, N4(node)->children[i]);
+      break;
+    case ART_NODE16:
+      for (i = 0; i < node->count; ++i)
+        subtree_free(tree, N16(node)->children[i]);
+      break;
+    case ART_NODE48:
+      for (i = 0; i < 48; ++i)
+        if (N48(node)->children[i])
+          subtree_free(tree, N48(node)->children[i]);
+      break;
+    default:
+      for (i = 0; i < 256; ++i)
+        if (N256(node)->children[i])
+          subtree_free(tree, N256(node)->children[i]);
+  }
+  node_free(tree, node);
+}
+
+/* external functions */
+int art_init(ArtTree *tree, BlibDestroyer value_dest) {
+  return art_init_alloc(tree, value_dest, NULL);
+}
+
+int art_init_alloc(ArtTree *tree, BlibDestroyer value_dest,
+                   const BlibAllocator *allocator) {
+  if (tree == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+  tree->root = NULL;
+  tree->size = 0;
+  tree->value_destroy = value_dest;
+  tree->allocator = allocator;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int art_destroy(ArtTree *tree) {
+  if (tree == NULL) return 0;
+  if (art_clear(tree)) return -1;
+  /* paranoid free */
+  memset(tree, 0, sizeof(ArtTree));
+  return 0;
+}
+
+int art_clear(ArtTree *tree) {
+  if (!art_valid(tree)) return -1;
+  if (tree->root) subtree_free(tree, tree->root);
+  tree->root = NULL;
+  tree->size = 0;
+  return 0;
+}
+
+void *art_get(const ArtTree *tree, const void *key, size_t key_size) {
+  if (!art_valid(tree)) return NULL;
+  const unsigned char *bytes = key;
+  const ArtNode *node = tree->root;
+  size_t depth = 0;
+  while (node) {
+    if (IS_LEAF(node)) {
+      const ArtLeaf *leaf = AS_LEAF(node);
+      if (!leaf_matches(leaf, bytes, key_size)) break;
+      last_status = BLIB_SUCCESS;
+      return leaf->value;
+    }
+    if (!partial_matches(node, bytes, key_size, depth)) break;
+    depth += node->prefix_len;
+    if (depth == key_size) {
+      if (node->leaf == NULL || !leaf_matches(node->leaf, bytes, key_size))
+        break;
+      last_status = BLIB_SUCCESS;
+      return node->leaf->value;
+    }
+    ArtNode **child = find_child((ArtNode *)node, bytes[depth++]);
+    node = child ? *child : NULL;
+  }
+  last_status = W_BLIB_NOT_FOUND;
+  return NULL;
+}
+
+/* copies the key; a key that is already present has its value replaced and
+ * destroyed
+ */
+int art_insert(ArtTree *tree, const void *key, size_t key_size, void *value) {
+  if (!art_valid(tree)) {
+    return -1;
+  } else if (key == NULL && key_size) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+  int status = insert_at(tree, &tree->root, key, key_size, 0, value);
+  if (status < 0) return -1;
+  if (status == 0) {
+    ++tree->size;
+    last_status = BLIB_SUCCESS;
+  } else {
+    last_status = W_BLIB_ELEMENT_REPLACED;
+  }
+  return 0;
+}
+
+int art_delete(ArtTree *tree, const void *key, size_t key_size) {
+  if (!art_valid(tree)) return -1;
+  ArtLeaf *leaf = delete_at(tree, &tree->root, key, key_size, 0);
+  if (leaf == NULL) {
+    last_status = W_BLIB_NOT_FOUND;
+    return -1;
+  }
+  if (tree->value_destroy) DESTROY_DATA(tree->value_destroy, leaf->value);
+  leaf_free(tree, leaf);
+  --tree->size;
+  return 0;
+}
+
+int art_contains(const ArtTree *tree, const void *key, size_t key_size) {
+  (void)art_get(tree, key, key_size);
+  return last_status == BLIB_SUCCESS;
+}
+
+/* the value of the longest key that is a prefix of key, storing its length
+ * in match_size if it is not NULL
+ */
+void *art_longest_prefix(const ArtTree *tree, const void *key,
+                         size_t key_size, size_t *match_size) {
+  if (!art_valid(tree)) return NULL;
+  const unsigned char *bytes = key;
+  const ArtNode *node = tree->root;
+  const ArtLeaf *best = NULL;
+  size_t depth = 0;
+  while (node) {
+    if (IS_LEAF(node)) {
+      if (leaf_prefixes(AS_LEAF(node), bytes, key_size)) best = AS_LEAF(node);
+      break;
+    }
+    if (!partial_matches(node, bytes, key_size, depth)) break;
+    depth += node->prefix_len;
+    if (node->leaf && leaf_prefixes(node->leaf, bytes, key_size))
+      best = node->leaf;
+    if (depth == key_size) break;
+    ArtNode **child = find_child((ArtNode *)node, bytes[depth++]);
+    node = child ? *child : NULL;
+  }
+  if (best == NULL) {
+    last_status = W_BLIB_NOT_FOUND;
+    return NULL;
+  }
+  if (match_size) *match_size = best->key_size;
+  last_status = BLIB_SUCCESS;
+  return best->value;
+}
+
+/* visits every key in order, returning the first nonzero value fn returns */
+int art_foreach(ArtTree *tree, ArtVisitor fn) {
+  if (!art_valid(tree) || !fn) return -1;
+  return tree->root ? visit(tree->root, fn) : 0;
+}
+
+/* visits the keys that start with prefix in order; they are all under the
+ * node where the prefix runs out
+ */
+int art_foreach_prefix(ArtTree *tree, const void *prefix, size_t prefix_size,
+                       ArtVisitor fn) {
+  if (!art_valid(tree) || !fn) return -1;
+  const unsigned char *bytes = prefix;
+  ArtNode *node = tree->root;
+  size_t depth = 0;
+  while (node) {
+    if (IS_LEAF(node)) {
+      const ArtLeaf *leaf = AS_LEAF(node);
+      if (leaf->key_size >= prefix_size &&
+          !memcmp(LEAF_KEY(leaf), bytes, prefix_size))
+        return visit(node, fn);
+      return 0;
+    }
+    size_t match = prefix_match(node, bytes, prefix_size, depth);
+    if (depth + match == prefix_size) return visit(node, fn);
+    if (match < node->prefix_len) return 0;
+    depth += node->prefix_len;
+    ArtNode **child = find_child(node, bytes[depth++]);
+    node = child ? *child : NULL;
+  }
+  return 0;
+}
+
+size_t art_size(const ArtTree *tree) { return tree->size; }
+int art_empty(const ArtTree *tree) { return tree->size == 0; }
+int art_status(const ArtTree *tree) {
+  (void)art_valid(tree);
+  return last_status;
+}
@@ -0,0 +1,97 @@
+#ifndef __BADART_H__
+#define __BADART_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+/* bytes of a compressed path stored in the node itself; longer paths are
+ * checked against the key of a leaf below
+ */
+#ifndef BLIB_ART_PREFIX
+#define BLIB_ART_PREFIX 10
+#endif
+
+/* The header shared by the four inner node types. `leaf` holds the key that
+ * ends exactly at this node, if there is one, since with explicit lengths a
+ * key may be a prefix of others.
+ */
+typedef struct art_node {
+  unsigned char type;
+  unsigned char partial[BLIB_ART_PREFIX];
+  unsigned short count;
+  size_t prefix_len;
+  struct art_leaf *leaf;
+} ArtNode;
+
+/* the key_size bytes of the key follow the struct */
+typedef struct art_leaf {
+  void *value;
+  size_t key_size;
+} ArtLeaf;
+
+/* Children of the inner nodes are tagged: a pointer with its low bit set is
+ * an ArtLeaf. Node4 and Node16 keep their key bytes sorted.
+ */
+typedef struct art_node4 {
+  ArtNode node;
+  unsigned char keys[4];
+  ArtNode *children[4];
+} ArtNode4;
+
+typedef struct art_node16 {
+  ArtNode node;
+  unsigned char keys[16];
+  ArtNode *children[16];
+} ArtNode16;
+
+/* index maps a byte to one more than its slot in children, or 0 */
+typedef struct art_node48 {
+  ArtNode node;
+  unsigned char index[256];
+  ArtNode *children[48];
+} ArtNode48;
+
+typedef struct art_node256 {
+  ArtNode node;
+  ArtNode *children[256];
+} ArtNode256;
+
+/* An adaptive radix tree mapping byte strings of explicit length to values.
+ * Each level consumes one byte of the key, and each inner node is the
+ * smallest of four sizes that fits its children. Chains of nodes with a
+ * single child are collapsed into a prefix stored in the node below, so
+ * lookups cost one step per branching byte of the key, not per byte. Keys
+ * are copied into their leaves, and iteration visits them in lexicographic
+ * order, shorter keys first.
+ */
+typedef struct art {
+  ArtNode *root;
+  size_t size;
+  BlibDestroyer value_destroy;
+  const BlibAllocator *allocator;
+} ArtTree;
+
+/* iteration callbacks return nonzero to stop early */
+typedef int (*ArtVisitor)(const void *key, size_t key_size, void *value);
+
+int art_init(ArtTree *tree, BlibDestroyer value_dest);
+int art_init_alloc(ArtTree *tree, BlibDestroyer value_dest,
+                   const BlibAllocator *allocator);
+int art_destroy(ArtTree *tree);
+int art_clear(ArtTree *tree);
+
+void *art_get(const ArtTree *tree, const void *key, size_t key_size);
+int art_insert(ArtTree *tree, const void *key, size_t key_size, void *value);
+int art_delete(ArtTree *tree, const void *key, size_t key_size);
+int art_contains(const ArtTree *tree, const void *key, size_t key_size);
+void *art_longest_prefix(const ArtTree *tree, const void *key,
+                         size_t key_size, size_t *match_size);
+
+int art_foreach(ArtTree *tree, ArtVisitor fn);
+int art_foreach_prefix(ArtTree *tree, const void *prefix, size_t prefix_size,
+                       ArtVisitor fn);
+
+size_t art_size(const ArtTree *tree);
+int art_empty(const ArtTree *tree);
+int art_status(const ArtTree *tree);
+#endif
@@ -0,0 +1,651 @@
+#include "badbpt.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalist.h"
+#include "badalloc.h"
+#include "badlib.h"
+#include "badvec.h"
+
+static BlibError last_status = BLIB_SUCCESS;
+
+/* Fewest keys a node other than the root may hold. Two nodes this thin fit
+ * in one when merged, along with the separator between them.
+ */
+#define MIN_KEYS ((BLIB_BPT_FANOUT - 1) / 2)
+
+#define INNER(NODE) ((BptInner *)(NODE))
+#define LEAF(NODE) ((BptLeaf *)(NODE))
+
+/* internal functions */
+static int bpt_valid(const BPTree *tree) {
+  if (tree == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  }
+  return 1;
+}
+
+/* The number of keys in node less than, or at most, key. Both scan every key
+ * without an early exit, which compiles to straight-line compares and adds
+ * that the compiler can vectorize and that never mispredict.
+ */
+static unsigned rank_below(const BptNode *node, uint64_t key) {
+  unsigned i, rank = 0;
+  for (i = 0; i < node->count; ++i) rank += node->keys[i] < key;
+  return rank;
+}
+
+static unsigned rank_through(const BptNode *node, uint64_t key) {
+  unsigned i, rank = 0;
+  for (i = 0; i < node->count; ++i) rank += node->keys[i] <= key;
+  return rank;
+}
+
+static BptLeaf *find_leaf(const BPTree *tree, uint64_t key) {
+  BptNode *node = tree->root;
+  if (node == NULL) return NULL;
+  while (!node->leaf) node = INNER(node)->children[rank_through(node, key)];
+  return LEAF(node);
+}
+
+static BptLeaf *leaf_alloc(const BPTree *tree) {
+  BptLeaf *leaf = blib_alloc(tree->allocator, sizeof(BptLeaf));
+  if (leaf == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return NULL;
+  }
+  leaf->node.count = 0;
+  leaf->node.leaf = 1;
+  leaf->prev = leaf->next = NULL;
+  return leaf;
+}
+
+static BptInner *inner_alloc(const BPTree *tree) {
+  BptInner *inner = blib_alloc(tree->allocator, sizeof(BptInner));
+  if (inner == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return NULL;
+  }
+  inner->node.count = 0;
+  inner->node.leaf = 0;
+  return inner;
+}
+
+static void node_free(const BPTree *tree, BptNode *node) {
+  blib_free(tree->allocator, node,
+            node->leaf ? sizeof(BptLeaf) : sizeof(BptInner));
+}
+
+static void subtree_free(const BPTree *tree, BptNode *node) {
+  if (!node->leaf) {
+    unsigned i;
+    for (i = 0; i <= node->count; ++i)
+      subtree_free(tree, INNER(node)->children[i]);
+  }
+  node_free(tree, node);
+}
+
+/* moves the upper half of the full child i of parent into a new sibling */
+static int split_child(BPTree *tree, BptInner *parent, unsigned i) {
+  BptNode *child = parent->children[i], *sibling;
+  unsigned half = BLIB_BPT_FANOUT / 2;
+  uint64_t separator;
+  if (child->leaf) {
+    BptLeaf *left = LEAF(child), *right = leaf_alloc(tree);
+    if (right == NULL) return -1;
+    right->node.count = BLIB_BPT_FANOUT - half;
+    memcpy(right->node.keys, child->keys + half,
+           sizeof(uint64_t) * right->node.count);
+    memcpy(right->values, left->values + half,
+           sizeof(void *) * right->node.count);
+    child->count = half;
+    right->prev = left;
+    right->next = left->next;
+    if (left->next)
+      left->next->prev = right;
+    else
+      tree->last = right;
+    left->next = right;
+    separator = right->node.keys[0];
+    sibling = &right->node;
+  } else {
+    /* the middle key moves up instead of being copied */
+    BptInner *right = inner_alloc(tree);
+    if (right == NULL) return -1;
+    right->node.count = BLIB_BPT_FANOUT - half - 1;
+    memcpy(right->node.keys, child->keys + half + 1,
+           sizeof(uint64_t) * right->node.count);
+    memcpy(right->children, INNER(child)->children + half + 1,
+           sizeof(BptNode *) * (right->node.count + 1));
+    separator = child->keys[half];
+    child->count = half;
+    sibling = &right->node;
+  }
+
+  memmove(parent->node.keys + i + 1, parent->node.keys + i,
+          sizeof(uint64_t) * (parent->node.count - i));
+  memmove(parent->children + i + 2, parent->children + i + 1,
+          sizeof(BptNode *) * (parent->node.count - i));
+  parent->node.keys[i] = separator;
+  parent->children[i + 1] = sibling;
+  ++parent->node.count;
+  return 0;
+}
+
+/* gives child i of parent one more key from its left sibling */
+static void borrow_left(BptInner *parent, unsigned i) {
+  BptNode *child = parent->children[i], *left = parent->children[i - 1];
+  memmove(child->keys + 1, child->keys, sizeof(uint64_t) * child->count);
+  if (child->leaf) {
+    memmove(LEAF(child)->values + 1, LEAF(child)->values,
+            sizeof(void *) * child->count);
+    child->keys[0] = left->keys[left->count - 1];
+    LEAF(child)->values[0] = LEAF(left)->values[left->count - 1];
+    parent->node.keys[i - 1] = child->keys[0];
+  } else {
+    memmove(INNER(child)->children + 1, INNER(child)->children,
+            sizeof(BptNode *) * (child->count + 1));
+    child->keys[0] = parent->node.keys[i - 1];
+    INNER(child)->children[0] = INNER(left)->children[left->count];
+    parent->node.keys[i - 1] = left->keys[left->count - 1];
+  }
+  --left->count;
+  ++child->count;
+}
+
+/* gives child i of parent one more key from its right sibling */
+static void borrow_right(BptInner *parent, unsigned i) {
+  BptNode *child = parent->children[i], *right = parent->children[i + 1];
+  if (child->leaf) {
+    child->keys[child->count] = right->keys[0];
+    LEAF(child)->values[child->count] = LEAF(right)->values[0];
+    memmove(LEAF(right)->values, LEAF(right)->values + 1,
+            sizeof(void *) * (right->count - 1));
+    memmove(right->keys, right->keys + 1,
+            sizeof(uint64_t) * (right->count - 1));
+    parent->node.keys[i] = right->keys[0];
+  } else {
+    child->keys[child->count] = parent->node.keys[i];
+    INNER(child)->children[child->count + 1] = INNER(right)->children[0];
+    parent->node.keys[i] = right->keys[0];
+    memmove(INNER(right)->children, INNER(right)->children + 1,
+            sizeof(BptNode *) * right->count);
+    memmove(right->keys, right->keys + 1,
+            sizeof(uint64_t) * (right->count - 1));
+  }
+  --right->count;
+  ++child->count;
+}
+
+/* merges child i + 1 of parent into child i */
+static void merge_children(BPTree *tree, BptInner *parent, unsigned i) {
+  BptNode *left = parent->children[i], *right = parent->children[i + 1];
+  if (left->leaf) {
+    memcpy(left->keys + left->count, right->keys,
+           sizeof(uint64_t) * right->count);
+    memcpy(LEAF(left)->values + left->count, LEAF(right)->values,
+           sizeof(void *) * right->count);
+    left->count += right->count;
+    LEAF(left)->next = LEAF(right)->next;
+    if (LEAF(right)->next)
+      LEAF(right)->next->prev = LEAF(left);
+    else
+      tree->last = LEAF(left);
+  } else {
+    left->keys[left->count] = parent->node.keys[i];
+    memcpy(left->keys + left->count + 1, right->keys,
+           sizeof(uint64_t) * right->count);
+    memcpy(INNER(left)->children + left->count + 1, INNER(right)->children,
+           sizeof(BptNode *) * (right->count + 1));
+    left->count += right->count + 1;
+  }
+  node_free(tree, right);
+
+  memmove(parent->node.keys + i, parent->node.keys + i + 1,
+          sizeof(uint64_t) * (parent->node.count - i - 1));
+  memmove(parent->children + i + 1, parent->children + i + 2,
+          sizeof(BptNode *) * (parent->node.count - i - 1));
+  --parent->node.count;
+}
+
+/* makes sure child i of parent can lose a key, returning the index of the
+ * child that now covers its keys
+ */
+static unsigned refill_child(BPTree *tree, BptInner *parent, unsigned i) {
+  BptNode *left = i > 0 ? parent->children[i - 1] : NULL;
+  BptNode *right = i < parent->node.count ? parent->children[i + 1] : NULL;
+  if (left && left->count > MIN_KEYS) {
+    borrow_left(parent, i);
+  } else if (right && right->count > MIN_KEYS) {
+    borrow_right(parent, i);
+  } else if (left) {
+    merge_children(tree, parent, --i);
+  } else {
+    merge_children(tree, parent, i);
+  }
+  return i;
+}
+
+/* the lowest key under node */
+static uint64_t subtree_min(const BptNode *node) {
+  while (!node->leaf) node = INNER(node)->children[0];
+  return node->keys[0];
+}
+
+/* Gathers count subtrees into as few parents as fit, spreading them evenly
+ * so that none is less than half full. Returns the new number of subtrees,
+ * which replace the old ones at the start of nodes, or 0 on failure, after
+ * freeing everything.
+ */
+static size_t build_level(const BPTree *tree, BptNode **nodes, size_t count) {
+  size_t per = BLIB_BPT_FANOUT + 1;
+  size_t parents = (count + per - 1) / per, p, j = 0;
+  for (p = 0; p < parents; ++p) {
+    size_t take = count / parents + (p < count % parents), k;
+    BptInner *inner = inner_alloc(tree);
+    if (inner == NULL) {
+      for (k = 0; k < p; ++k) subtree_free(tree, nodes[k]);
+      for (k = j; k < count; ++k) subtree_free(tree, nodes[k]);
+      return 0;
+    }
+    for (k = 0; k < take; ++k) {
+      inner->children[k] = nodes[j + k];
+      if (k) inner->node.keys[k - 1] = subtree_min(nodes[j + k]);
+    }
+    inner->node.count = (unsigned)take - 1;
+    j += take;
+    nodes[p] = &inner->node;
+  }
+  return parents;
+}
+
+/* external functions */
+int bpt_init(BPTree *tree, BlibDestroyer value_dest) {
+  return bpt_init_alloc(tree, value_dest, NULL);
+}
+
+int bpt_init_alloc(BPTree *tree, BlibDestroyer value_dest,
+                   const BlibAllocator *allocator) {
+  if (tree == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+  tree->root = NULL;
+  tree->first = tree->last = NULL;
+  tree->size = 0;
+  tree->value_destroy = value_dest;
+  tree->allocator = allocator;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+/* Bulk loads count strictly increasing keys, and their values if values is
+ * not NULL, bottom up in O(n): leaves are filled evenly and in order, then
+ * each level of parents is built over the one below.
+ */
+int bpt_from_sorted(BPTree *tree, const uint64_t *keys, void *const *values,
+                    size_t count, BlibDestroyer value_dest) {
+  return bpt_from_sorted_alloc(tree, keys, values, count, value_dest, NULL);
+}
+
+int bpt_from_sorted_alloc(BPTree *tree, const uint64_t *keys,
+                          void *const *values, size_t count,
+                          BlibDestroyer value_dest,
+                          const BlibAllocator *allocator) {
+  if (bpt_init_alloc(tree, value_dest, allocator)) {
+    return -1;
+  } else if (count == 0) {
+    return 0;
+  } else if (keys == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+  size_t i;
+  for (i = 1; i < count; ++i) {
+    if (keys[i - 1] >= keys[i]) {
+      last_status = BLIB_COMPARE_ERROR;
+      return -1;
+    }
+  }
+
+  size_t leaves = (count + BLIB_BPT_FANOUT - 1) / BLIB_BPT_FANOUT, l, j = 0;
+  size_t nodes_size = sizeof(BptNode *) * leaves;
+  BptNode **nodes = blib_alloc(tree->allocator, nodes_size);
+  if (nodes == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  for (l = 0; l < leaves; ++l) {
+    size_t take = count / leaves + (l < count % leaves);
+    BptLeaf *leaf = leaf_alloc(tree);
+    if (leaf == NULL) {
+      while (l-- > 0) node_free(tree, nodes[l]);
+      blib_free(tree->allocator, nodes, nodes_size);
+      return -1;
+    }
+    memcpy(leaf->node.keys, keys + j, sizeof(uint64_t) * take);
+    if (values)
+      memcpy(leaf->values, values + j, sizeof(void *) * take);
+    else
+      memset(leaf->values, 0, sizeof(void *) * take);
+    leaf->node.count = (unsigned)take;
+    leaf->prev = l ? LEAF(nodes[l - 1]) : NULL;
+    if (l) LEAF(nodes[l - 1])->next = leaf;
+    nodes[l] = &leaf->node;
+    j += take;
+  }
+  tree->first = LEAF(nodes[0]);
+  tree->last = LEAF(nodes[leaves - 1]);
+
+  while (leaves > 1) {
+    leaves = build_level(tree, nodes, leaves);
+    if (leaves == 0) {
+      blib_free(tree->allocator, nodes, nodes_size);
+      bpt_init_alloc(tree, value_dest, allocator);
+      last_status = BLIB_ALLOC_FAIL;
+      return -1;
+    }
+  }
+  tree->root = nodes[0];
+  tree->size = count;
+  blib_free(tree->allocator, nodes, nodes_size);
+  return 0;
+}
+
+int bpt_destroy(BPTree *tree) {
+  if (tree == NULL) return 0;
+  if (bpt_clear(tree)) return -1;
+  /* paranoid free */
+  memset(tree, 0, sizeof(BPTree));
+  return 0;
+}
+
+int bpt_clear(BPTree *tree) {
+  if (!bpt_valid(tree)) return -1;
+  if (tree->value_destroy) {
+    BptLeaf *leaf;
+    unsigned i;
+    for (leaf = tree->first; leaf; leaf = leaf->next)
+      for (i = 0; i < leaf->node.count; ++i)
+        DESTROY_DATA(tree->value_destroy, leaf->values[i]);
+  }
+  if (tree->root) subtree_free(tree, tree->root);
+  tree->root = NULL;
+  tree->first = tree->last = NULL;
+  tree->size = 0;
+  return 0;
+}
+
+void *bpt_get(const BPTree *tree, uint64_t key) {
+  if (!bpt_valid(tree)) return NULL;
+  BptLeaf *leaf = find_leaf(tree, key);
+  if (leaf) {
+    unsigned i = rank_below(&leaf->node, key);
+    if (i < leaf->node.count && leaf->node.keys[i] == key) {
+      last_status = BLIB_SUCCESS;
+      return leaf->values[i];
+    }
+  }
+  last_status = W_BLIB_NOT_FOUND;
+  return NULL;
+}
+
+/* replaces and destroys the value of a key that is already present */
+int bpt_insert(BPTree *tree, uint64_t key, void *value) {
+  if (!bpt_valid(tree)) return -1;
+  if (tree->root == NULL) {
+    BptLeaf *leaf = leaf_alloc(tree);
+    if (leaf == NULL) return -1;
+    tree->root = &leaf->node;
+    tree->first = tree->last = leaf;
+  }
+  if (tree->root->count == BLIB_BPT_FANOUT) {
+    BptInner *root = inner_alloc(tree);
+    if (root == NULL) return -1;
+    root->children[0] = tree->root;
+    if (split_child(tree, root, 0)) {
+      node_free(tree, &root->node);
+      return -1;
+    }
+    tree->root = &root->node;
+  }
+
+  /* full nodes are split before descending into them, so there is always
+   * room in the parent for the new separator
+   */
+  BptNode *node = tree->root;
+  while (!node->leaf) {
+    unsigned i = rank_through(node, key);
+    if (INNER(node)->children[i]->count == BLIB_BPT_FANOUT) {
+      if (split_child(tree, INNER(node), i)) return -1;
+      if (key >= node->keys[i]) ++i;
+    }
+    node = INNER(node)->children[i];
+  }
+
+  BptLeaf *leaf = LEAF(node);
+  unsigned i = rank_below(node, key);
+  if (i < node->count && node->keys[i] == key) {
+    if (tree->value_destroy && leaf->values[i] != value)
+      DESTROY_DATA(tree->value_destroy, leaf->values[i]);
+    leaf->values[i] = value;
+    last_status = W_BLIB_ELEMENT_REPLACED;
+    return 0;
+  }
+  memmove(node->keys + i + 1, node->keys + i,
+          sizeof(uint64_t) * (node->count - i));
+  memmove(leaf->values + i + 1, leaf->values + i,
+          sizeof(void *) * (node->count - i));
+  node->keys[i] = key;
+  leaf->values[i] = value;
+  ++node->count;
+  ++tree->size;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int bpt_delete(BPTree *tree, uint64_t key) {
+  if (!bpt_valid(tree)) return -1;
+  if (tree->root == NULL) {
+    last_status = W_BLIB_NOT_FOUND;
+    return -1;
+  }
+
+  /* thin nodes are refilled before descending into them, so the leaf can
+   * lose a key and merges never cascade back up
+   */
+  BptNode *node = tree->root;
+  while (!node->leaf) {
+    unsigned i = rank_through(node, key);
+    if (INNER(node)->children[i]->count <= MIN_KEYS)
+      i = refill_child(tree, INNER(node), i);
+    BptNode *child = INNER(node)->children[i];
+    if (node == tree->root && node->count == 0) {
+      tree->root = child;
+      node_free(tree, node);
+    }
+    node = child;
+  }
+
+  BptLeaf *leaf = LEAF(node);
+  unsigned i = rank_below(node, key);
+  if (i == node->count || node->keys[i] != key) {
+    last_status = W_BLIB_NOT_FOUND;
+    return -1;
+  }
+  if (tree->value_destroy) DESTROY_DATA(tree->value_destroy, leaf->values[i]);
+  memmove(node->keys + i, node->keys + i + 1,
+          sizeof(uint64_t) * (node->count - i - 1));
+  memmove(leaf->values + i, leaf->values + i + 1,
+          sizeof(void *) * (node->count - i - 1));
+  --node->count;
+  if (--tree->size == 0) {
+    node_free(tree, tree->root);
+    tree->root = NULL;
+    tree->first = tree->last = NULL;
+  }
+  return 0;
+}
+
+int bpt_contains(const BPTree *tree, uint64_t key) {
+  if (!bpt_valid(tree)) return 0;
+  BptLeaf *leaf = find_leaf(tree, key);
+  if (leaf == NULL) return 0;
+  unsigned i = rank_below(&leaf->node, key);
+  return i < leaf->node.count && leaf->node.keys[i] == key;
+}
+
+/* appends every key in order to out, a Vector of uint64_t */
+int bpt_keys(const BPTree *tree, Vector *out) {
+  if (!bpt_valid(tree)) {
+    return -1;
+  } else if (out == NULL || out->element_size != sizeof(uint64_t)) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+  size_t j = vec_size(out);
+  if (vec_resize(out, j + tree->size, NULL)) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  BptLeaf *leaf;
+  for (leaf = tree->first; leaf; leaf = leaf->next) {
+    memcpy(out->data + j * sizeof(uint64_t), leaf->node.keys,
+           sizeof(uint64_t) * leaf->node.count);
+    j += leaf->node.count;
+  }
+  return 0;
+}
+
+/* appends every value in key order to out */
+int bpt_values(const BPTree *tree, ArrayList *out) {
+  if (!bpt_valid(tree)) {
+    return -1;
+  } else if (out == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+  BptLeaf *leaf;
+  for (leaf = tree->first; leaf; leaf = leaf->next) {
+    if (alist_append_range(out, leaf->values, leaf->node.count)) {
+      last_status = BLIB_ALLOC_FAIL;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int bpt_foreach_value(BPTree *tree, void (*fn)(void *)) {
+  if (!bpt_valid(tree) || !fn) return -1;
+  BptLeaf *leaf;
+  unsigned i;
+  for (leaf = tree->first; leaf; leaf = leaf->next)
+    for (i = 0; i < leaf->node.count; ++i) fn(leaf->values[i]);
+  return 0;
+}
+
+int bpt_foreach_pair(BPTree *tree, void (*fn)(uint64_t, void *)) {
+  if (!bpt_valid(tree) || !fn) return -1;
+  BptLeaf *leaf;
+  unsigned i;
+  for (leaf = tree->first; leaf; leaf = leaf->next)
+    for (i = 0; i < leaf->node.count; ++i)
+      fn(leaf->node.keys[i], leaf->values[i]);
+  return 0;
+}
+
+/* calls fn, if it is not NULL, on every pair with a key in [low, high) in
+ * order, and returns how many there were
+ */
+size_t bpt_scan(const BPTree *tree, uint64_t low, uint64_t high,
+                void (*fn)(uint64_t, void *)) {
+  if (!bpt_valid(tree) || low >= high) return 0;
+  BptLeaf *leaf = find_leaf(tree, low);
+  size_t count = 0;
+  unsigned i = leaf ? rank_below(&leaf->node, low) : 0;
+  for (; leaf; leaf = leaf->next, i = 0) {
+    for (; i < leaf->node.count; ++i) {
+      if (leaf->node.keys[i] >= high) return count;
+      if (fn) fn(leaf->node.keys[i], leaf->values[i]);
+      ++count;
+    }
+  }
+  return count;
+}
+
+/* the cursor functions return 0 when they leave cursor at a key, and -1
+ * when they leave it past the end
+ */
+int bpt_first(const BPTree *tree, BptCursor *cursor) {
+  if (!bpt_valid(tree)) return -1;
+  cursor->leaf = tree->first;
+  cursor->index = 0;
+  return cursor->leaf ? 0 : -1;
+}
+
+int bpt_last(const BPTree *tree, BptCursor *cursor) {
+  if (!bpt_valid(tree)) return -1;
+  cursor->leaf = tree->last;
+  cursor->index = tree->last ? tree->last->node.count - 1 : 0;
+  return cursor->leaf ? 0 : -1;
+}
+
+/* moves to the first key not less than key */
+int bpt_lower_bound(const BPTree *tree, uint64_t key, BptCursor *cursor) {
+  if (!bpt_valid(tree)) return -1;
+  cursor->leaf = find_leaf(tree, key);
+  cursor->index = cursor->leaf ? rank_below(&cursor->leaf->node, key) : 0;
+  if (cursor->leaf && cursor->index == cursor->leaf->node.count) {
+    cursor->leaf = cursor->leaf->next;
+    cursor->index = 0;
+  }
+  return cursor->leaf ? 0 : -1;
+}
+
+/* moves to the first key greater than key */
+int bpt_upper_bound(const BPTree *tree, uint64_t key, BptCursor *cursor) {
+  if (!bpt_valid(tree)) return -1;
+  cursor->leaf = find_leaf(tree, key);
+  cursor->index = cursor->leaf ? rank_through(&cursor->leaf->node, key) : 0;
+  if (cursor->leaf && cursor->index == cursor->leaf->node.count) {
+    cursor->leaf = cursor->leaf->next;
+    cursor->index = 0;
+  }
+  return cursor->leaf ? 0 : -1;
+}
+
+int bpt_next(BptCursor *cursor) {
+  if (cursor->leaf == NULL) return -1;
+  if (++cursor->index == cursor->leaf->node.count) {
+    cursor->leaf = cursor->leaf->next;
+    cursor->index = 0;
+  }
+  return cursor->leaf ? 0 : -1;
+}
+
+int bpt_prev(BptCursor *cursor) {
+  if (cursor->leaf == NULL) return -1;
+  if (cursor->index-- == 0) {
+    cursor->leaf = cursor->leaf->prev;
+    cursor->index = cursor->leaf ? cursor->leaf->node.count - 1 : 0;
+  }
+  return cursor->leaf ? 0 : -1;
+}
+
+uint64_t bpt_key(const BptCursor *cursor) {
+  return cursor->leaf->node.keys[cursor->index];
+}
+
+void *bpt_value(const BptCursor *cursor) {
+  return cursor->leaf->values[cursor->index];
+}
+
+size_t bpt_size(const BPTree *tree) { return tree->size; }
+int bpt_empty(const BPTree *tree) { return tree->size == 0; }
+int bpt_status(const BPTree *tree) {
+  (void)bpt_valid(tree);
+  return last_status;
+}
@@ -0,0 +1,95 @@
+#ifndef __BADBPT_H__
+#define __BADBPT_H__
+#include <stddef.h>
+#include <stdint.h>
+
+#include "badalist.h"
+#include "badlib.h"
+#include "badvec.h"
+
+/* most keys held by a node; 32 keys fill four 64-byte cache lines */
+#ifndef BLIB_BPT_FANOUT
+#define BLIB_BPT_FANOUT 32
+#endif
+
+/* keys are kept contiguous at the start of every node, so that finding a
+ * position is a linear scan of a few cache lines
+ */
+typedef struct bpt_node {
+  uint64_t keys[BLIB_BPT_FANOUT];
+  unsigned count;
+  unsigned leaf;
+} BptNode;
+
+/* children[i] holds the keys below keys[i], and children[count] the rest */
+typedef struct bpt_inner {
+  BptNode node;
+  BptNode *children[BLIB_BPT_FANOUT + 1];
+} BptInner;
+
+typedef struct bpt_leaf {
+  BptNode node;
+  void *values[BLIB_BPT_FANOUT];
+  struct bpt_leaf *prev;
+  struct bpt_leaf *next;
+} BptLeaf;
+
+/* A B+tree mapping uint64_t keys to values. Only the leaves hold values, and
+ * they are linked in key order, so scans run through consecutive leaves
+ * without going back up the tree. Nodes are split on the way down by
+ * inserts and refilled on the way down by deletes, so every node but the
+ * root stays at least half full.
+ */
+typedef struct bpt {
+  BptNode *root;
+  BptLeaf *first;
+  BptLeaf *last;
+  size_t size;
+  BlibDestroyer value_destroy;
+  const BlibAllocator *allocator;
+} BPTree;
+
+/* a position in the tree; leaf is NULL past the end */
+typedef struct bpt_cursor {
+  BptLeaf *leaf;
+  unsigned index;
+} BptCursor;
+
+int bpt_init(BPTree *tree, BlibDestroyer value_dest);
+int bpt_init_alloc(BPTree *tree, BlibDestroyer value_dest,
+                   const BlibAllocator *allocator);
+int bpt_from_sorted(BPTree *tree, const uint64_t *keys, void *const *values,
+                    size_t count, BlibDestroyer value_dest);
+int bpt_from_sorted_alloc(BPTree *tree, const uint64_t *keys,
+                          void *const *values, size_t count,
+                          BlibDestroyer value_dest,
+                          const BlibAllocator *allocator);
+int bpt_destroy(BPTree *tree);
+int bpt_clear(BPTree *tree);
+
+void *bpt_get(const BPTree *tree, uint64_t key);
+int bpt_insert(BPTree *tree, uint64_t key, void *value);
+int bpt_delete(BPTree *tree, uint64_t key);
+int bpt_contains(const BPTree *tree, uint64_t key);
+int bpt_keys(const BPTree *tree, Vector *out);
+int bpt_values(const BPTree *tree, ArrayList *out);
+
+int bpt_foreach_value(BPTree *tree, void (*fn)(void *));
+int bpt_foreach_pair(BPTree *tree, void (*fn)(uint64_t, void *));
+size_t bpt_scan(const BPTree *tree, uint64_t low, uint64_t high,
+                void (*fn)(uint64_t, void *));
+
+/* ordered access */
+int bpt_first(const BPTree *tree, BptCursor *cursor);
+int bpt_last(const BPTree *tree, BptCursor *cursor);
+int bpt_lower_bound(const BPTree *tree, uint64_t key, BptCursor *cursor);
+int bpt_upper_bound(const BPTree *tree, uint64_t key, BptCursor *cursor);
+int bpt_next(BptCursor *cursor);
+int bpt_prev(BptCursor *cursor);
+uint64_t bpt_key(const BptCursor *cursor);
+void *bpt_value(const BptCursor *cursor);
+
+size_t bpt_size(const BPTree *tree);
+int bpt_empty(const BPTree *tree);
+int bpt_status(const BPTree *tree);
+#endif
@@ -0,0 +1,310 @@
+#include "badclist.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+
+#define CHUNK_OF(INDEX) ((INDEX) >> BLIB_CLIST_CHUNK_SHIFT)
+#define OFFSET_OF(INDEX) ((INDEX) & (BLIB_CLIST_CHUNK_SIZE - 1))
+#define SLOT(LIST, INDEX) ((LIST)->chunks[CHUNK_OF(INDEX)] + OFFSET_OF(INDEX))
+
+static BlibError last_status = BLIB_SUCCESS;
+
+/* internal functions */
+static int clist_valid(const ChunkList *list) {
+  if (list == NULL || list->dir_cap == 0) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  } else if (list->chunks == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return 0;
+  } else {
+    return 1;
+  }
+}
+
+/* makes sure there are enough chunks to hold `size` elements */
+static int clist_reserve(ChunkList *list, size_t size) {
+  size_t needed = CHUNK_OF(size + BLIB_CLIST_CHUNK_SIZE - 1);
+  if (needed > list->dir_cap) {
+    size_t dir_cap = list->dir_cap;
+    while (dir_cap < needed) dir_cap <<= 1;
+    void ***new_chunks = blib_realloc(list->allocator, list->chunks,
+                                      sizeof(void **) * list->dir_cap,
+                                      sizeof(void **) * dir_cap);
+    if (new_chunks == NULL) {
+      last_status = BLIB_ALLOC_FAIL;
+      return -1;
+    }
+    list->chunks = new_chunks;
+    list->dir_cap = dir_cap;
+  }
+
+  while (list->chunk_count < needed) {
+    void **chunk =
+        blib_alloc(list->allocator, sizeof(void *) * BLIB_CLIST_CHUNK_SIZE);
+    if (chunk == NULL) {
+      last_status = BLIB_ALLOC_FAIL;
+      return -1;
+    }
+    list->chunks[list->chunk_count++] = chunk;
+  }
+  return 0;
+}
+
+/* frees the chunks that lie entirely past `size` elements */
+static void clist_trim(ChunkList *list, size_t size) {
+  size_t needed = CHUNK_OF(size + BLIB_CLIST_CHUNK_SIZE - 1);
+  while (list->chunk_count > needed)
+    blib_free(list->allocator, list->chunks[--list->chunk_count],
+              sizeof(void *) * BLIB_CLIST_CHUNK_SIZE);
+}
+
+static void clist_zero(ChunkList *list, size_t start, size_t end) {
+  while (start < end) {
+    size_t run = BLIB_CLIST_CHUNK_SIZE - OFFSET_OF(start);
+    if (run > end - start) run = end - start;
+    memset(SLOT(list, start), 0, sizeof(void *) * run);
+    start += run;
+  }
+}
+
+static void clist_destroy_range(ChunkList *list, size_t start, size_t end,
+                                BlibDestroyer destroy) {
+  for (; start < end; ++start) {
+    void **slot = SLOT(list, start);
+    if (*slot) {
+      if (destroy) DESTROY_DATA(destroy, *slot);
+      *slot = NULL;
+    }
+  }
+}
+
+/* external functions */
+int clist_init(ChunkList *list, size_t size) {
+  return clist_init_alloc(list, size, NULL);
+}
+
+int clist_init_alloc(ChunkList *list, size_t size,
+                     const BlibAllocator *allocator) {
+  if (list == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+
+  list->allocator = allocator;
+  list->chunks = blib_alloc(allocator, sizeof(void **));
+  if (list->chunks == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  list->dir_cap = 1;
+  list->chunk_count = 0;
+  list->size = 0;
+  if (clist_reserve(list, size)) {
+    clist_destroy(list, NULL);
+    return -1;
+  }
+  clist_zero(list, 0, size);
+  list->size = size;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int clist_destroy(ChunkList *list, BlibDestroyer destroy) {
+  if (list == NULL)
+    return 0;
+  else if (!clist_valid(list))
+    return -1;
+
+  clist_destroy_range(list, 0, list->size, destroy);
+  clist_trim(list, 0);
+  blib_free(list->allocator, list->chunks, sizeof(void **) * list->dir_cap);
+  /* paranoid free */
+  memset(list, 0, sizeof(ChunkList));
+  return 0;
+}
+
+int clist_clear(ChunkList *list, BlibDestroyer destroy) {
+  if (!clist_valid(list)) return -1;
+  clist_destroy_range(list, 0, list->size, destroy);
+  return 0;
+}
+
+void *clist_get(const ChunkList *list, size_t index) {
+  if (!clist_valid(list)) {
+    return NULL;
+  } else if (index >= list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return NULL;
+  } else {
+    void *ret = *SLOT(list, index);
+    last_status = ret == NULL ? W_BLIB_NOT_FOUND : BLIB_SUCCESS;
+    return ret;
+  }
+}
+
+/* address of the slot holding the element at index, which does not change
+ * as the list grows
+ */
+void **clist_slot(const ChunkList *list, size_t index) {
+  if (!clist_valid(list)) {
+    return NULL;
+  } else if (index >= list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return NULL;
+  }
+  return SLOT(list, index);
+}
+
+int clist_insert(ChunkList *list, void *element, size_t index,
+                 BlibDestroyer destroy) {
+  if (!clist_valid(list)) {
+    return -1;
+  } else if (index > list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  } else if (index == list->size) {
+    return clist_push(list, element);
+  }
+
+  void **slot = SLOT(list, index);
+  if (*slot && destroy) DESTROY_DATA(destroy, *slot);
+  *slot = element;
+  return 0;
+}
+
+int clist_delete(ChunkList *list, size_t index, BlibDestroyer destroy) {
+  if (!clist_valid(list)) {
+    return -1;
+  } else if (index >= list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+
+  clist_destroy_range(list, index, index + 1, destroy);
+  return 0;
+}
+
+int clist_push(ChunkList *list, void *element) {
+  if (!clist_valid(list)) return -1;
+  if (OFFSET_OF(list->size) == 0 && clist_reserve(list, list->size + 1))
+    return -1;
+  *SLOT(list, list->size) = element;
+  ++list->size;
+  return 0;
+}
+
+/* chunks are kept after popping so that alternating pushes and pops at a
+ * chunk boundary do not allocate; clist_resize releases them
+ */
+int clist_pop(ChunkList *list, BlibDestroyer destroy) {
+  if (!clist_valid(list)) {
+    return -1;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return -1;
+  }
+
+  clist_destroy_range(list, list->size - 1, list->size, destroy);
+  --list->size;
+  return 0;
+}
+
+void *clist_peek(ChunkList *list) {
+  if (!clist_valid(list)) {
+    return NULL;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  } else {
+    void *ret = *SLOT(list, list->size - 1);
+    last_status = ret == NULL ? W_BLIB_NOT_FOUND : BLIB_SUCCESS;
+    return ret;
+  }
+}
+
+/* if compare is NULL, elements are compared by address */
+size_t clist_find(const ChunkList *list, void *target, BlibComparator compare) {
+  if (!clist_valid(list)) return -1;
+
+  size_t i;
+  for (i = 0; i < list->size; ++i) {
+    void *element = *SLOT(list, i);
+    if (element && (compare ? compare(target, element) : target == element))
+      return i;
+  }
+
+  last_status = W_BLIB_NOT_FOUND;
+  return list->size;
+}
+
+size_t clist_rfind(const ChunkList *list, void *target,
+                   BlibComparator compare) {
+  if (!clist_valid(list)) return -1;
+
+  size_t i;
+  for (i = list->size; i > 0; --i) {
+    void *element = *SLOT(list, i - 1);
+    if (element && (compare ? compare(target, element) : target == element))
+      return i - 1;
+  }
+
+  last_status = W_BLIB_NOT_FOUND;
+  return list->size;
+}
+
+void clist_foreach(ChunkList *list, void (*fn)(void *)) {
+  if (!clist_valid(list)) {
+    return;
+  } else if (!fn) {
+    last_status = BLIB_INVALID_STRUCT;
+    return;
+  }
+
+  size_t i, j;
+  for (i = 0; i < list->size; i += BLIB_CLIST_CHUNK_SIZE) {
+    void **chunk = list->chunks[CHUNK_OF(i)];
+    size_t run = list->size - i < BLIB_CLIST_CHUNK_SIZE
+                     ? list->size - i
+                     : BLIB_CLIST_CHUNK_SIZE;
+    for (j = 0; j < run; ++j)
+      if (chunk[j]) fn(chunk[j]);
+  }
+}
+
+int clist_resize(ChunkList *list, size_t size, BlibDestroyer destroy) {
+  if (!clist_valid(list)) return -1;
+
+  if (size > list->size) {
+    if (clist_reserve(list, size)) return -1;
+    clist_zero(list, list->size, size);
+  } else {
+    clist_destroy_range(list, size, list->size, destroy);
+    clist_trim(list, size);
+  }
+  list->size = size;
+  return 0;
+}
+
+size_t clist_count(ChunkList *list) {
+  if (!clist_valid(list)) return -1;
+
+  size_t i, count = 0;
+  for (i = 0; i < list->size; ++i)
+    if (*SLOT(list, i)) ++count;
+  return count;
+}
+
+size_t clist_size(const ChunkList *list) { return list->size; }
+size_t clist_cap(const ChunkList *list) {
+  return list->chunk_count << BLIB_CLIST_CHUNK_SHIFT;
+}
+int clist_empty(const ChunkList *list) { return list->size == 0; }
+int clist_status(const ChunkList *list) {
+  (void)clist_valid(list);
+  return last_status;
+}
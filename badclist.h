@@ -0,0 +1,57 @@
+#ifndef __BADCLIST_H__
+#define __BADCLIST_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+/* log2 of the number of elements in each chunk */
+#ifndef BLIB_CLIST_CHUNK_SHIFT
+#define BLIB_CLIST_CHUNK_SHIFT 10
+#endif
+#define BLIB_CLIST_CHUNK_SIZE ((size_t)1 << BLIB_CLIST_CHUNK_SHIFT)
+
+#define BLIB_CLIST_EMPTY \
+  { NULL, 0, 0, 0, NULL }
+
+/* A segmented ArrayList. Elements are stored in fixed-size chunks that are
+ * never reallocated, so growing the list never copies elements and pointers
+ * returned by clist_slot stay valid until that element is removed by
+ * clist_pop, clist_resize or clist_destroy. Only the directory of chunk
+ * pointers is reallocated.
+ */
+typedef struct clist {
+  void ***chunks;
+  size_t chunk_count;
+  size_t dir_cap;
+  size_t size;
+  const BlibAllocator *allocator;
+} ChunkList;
+
+int clist_init(ChunkList *list, size_t size);
+int clist_init_alloc(ChunkList *list, size_t size,
+                     const BlibAllocator *allocator);
+int clist_destroy(ChunkList *list, BlibDestroyer destroyer);
+int clist_clear(ChunkList *list, BlibDestroyer destroyer);
+
+void *clist_get(const ChunkList *list, size_t index);
+void **clist_slot(const ChunkList *list, size_t index);
+int clist_insert(ChunkList *list, void *data, size_t index,
+                 BlibDestroyer destroyer);
+int clist_delete(ChunkList *list, size_t index, BlibDestroyer destroyer);
+
+int clist_push(ChunkList *list, void *data);
+int clist_pop(ChunkList *list, BlibDestroyer destroyer);
+void *clist_peek(ChunkList *list);
+
+size_t clist_find(const ChunkList *list, void *target, BlibComparator compare);
+size_t clist_rfind(const ChunkList *list, void *target,
+                   BlibComparator compare);
+void clist_foreach(ChunkList *list, void (*fn)(void *));
+int clist_resize(ChunkList *list, size_t size, BlibDestroyer destroyer);
+size_t clist_count(ChunkList *list);
+
+size_t clist_size(const ChunkList *list);
+size_t clist_cap(const ChunkList *list);
+int clist_empty(const ChunkList *list);
+int clist_status(const ChunkList *list);
+#endif
@@ -0,0 +1,271 @@
+#include "baddeque.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+
+#define DEQUE_INITIAL_CAP 8
+/* the largest power of two whose byte count fits in a size_t */
+#define DEQUE_MAX_CAP ((size_t)-1 / sizeof(void *) / 2 + 1)
+#define SLOT(DEQUE, INDEX) \
+  ((DEQUE)->data[((DEQUE)->head + (INDEX)) & ((DEQUE)->cap - 1)])
+
+static BlibError last_status = BLIB_SUCCESS;
+
+/* internal functions */
+static int deque_valid(const Deque *deque) {
+  if (deque == NULL || deque->data == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  }
+  return 1;
+}
+
+/* grows the buffer to `cap`, a power of two, and moves the wrapped part of
+ * the ring so that it follows the rest of the elements again
+ */
+static int deque_grow(Deque *deque, size_t cap) {
+  if (cap == 0 || cap > DEQUE_MAX_CAP) {
+    last_status = BLIB_INVALID_SIZE;
+    return -1;
+  }
+  void **new_data = blib_realloc(deque->allocator, deque->data,
+                                 sizeof(void *) * deque->cap,
+                                 sizeof(void *) * cap);
+  if (new_data == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  deque->data = new_data;
+  if (deque->head + deque->size > deque->cap) {
+    size_t wrapped = deque->head + deque->size - deque->cap;
+    size_t tail_room = cap - deque->cap;
+    if (wrapped <= tail_room) {
+      memcpy(deque->data + deque->cap, deque->data, sizeof(void *) * wrapped);
+    } else {
+      /* move the front segment to the end of the new buffer instead */
+      size_t front = deque->cap - deque->head;
+      memmove(deque->data + cap - front, deque->data + deque->head,
+             sizeof(void *) * front);
+      deque->head = cap - front;
+    }
+  }
+  deque->cap = cap;
+  return 0;
+}
+
+/* external functions */
+int deque_init(Deque *deque, BlibDestroyer dest, BlibComparator comp) {
+  return deque_init_alloc(deque, dest, comp, NULL);
+}
+
+int deque_init_alloc(Deque *deque, BlibDestroyer dest, BlibComparator comp,
+                     const BlibAllocator *allocator) {
+  if (deque == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+  deque->allocator = allocator;
+  deque->data = blib_alloc(allocator, sizeof(void *) * DEQUE_INITIAL_CAP);
+  if (deque->data == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  deque->head = 0;
+  deque->size = 0;
+  deque->cap = DEQUE_INITIAL_CAP;
+  deque->data_destroy = dest;
+  deque->data_compare = comp;
+  return 0;
+}
+
+int deque_destroy(Deque *deque) {
+  if (deque == NULL) return 0;
+  if (deque_clear(deque)) return -1;
+  blib_free(deque->allocator, deque->data, sizeof(void *) * deque->cap);
+  /* paranoid free */
+  memset(deque, 0, sizeof(Deque));
+  return 0;
+}
+
+int deque_clear(Deque *deque) {
+  if (!deque_valid(deque)) return -1;
+  if (deque->data_destroy) {
+    size_t i;
+    for (i = 0; i < deque->size; ++i)
+      DESTROY_DATA(deque->data_destroy, SLOT(deque, i));
+  }
+  deque->head = 0;
+  deque->size = 0;
+  return 0;
+}
+
+int deque_reserve(Deque *deque, size_t cap) {
+  if (!deque_valid(deque)) {
+    return -1;
+  } else if (cap > DEQUE_MAX_CAP) {
+    last_status = BLIB_INVALID_SIZE;
+    return -1;
+  }
+  size_t new_cap = deque->cap;
+  while (new_cap < cap) new_cap <<= 1;
+  return new_cap != deque->cap ? deque_grow(deque, new_cap) : 0;
+}
+
+/* queue functions */
+int deque_push_front(Deque *deque, void *element) {
+  if (!deque_valid(deque)) return -1;
+  if (deque->size == deque->cap && deque_grow(deque, deque->cap << 1))
+    return -1;
+  deque->head = (deque->head - 1) & (deque->cap - 1);
+  deque->data[deque->head] = element;
+  ++deque->size;
+  return 0;
+}
+
+void *deque_pop_front(Deque *deque) {
+  if (!deque_valid(deque)) {
+    return NULL;
+  } else if (deque->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  void *ret = deque->data[deque->head];
+  deque->head = (deque->head + 1) & (deque->cap - 1);
+  --deque->size;
+  return ret;
+}
+
+void *deque_front(const Deque *deque) {
+  if (!deque_valid(deque)) {
+    return NULL;
+  } else if (deque->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return deque->data[deque->head];
+}
+
+/* deque functions */
+int deque_push_back(Deque *deque, void *element) {
+  if (!deque_valid(deque)) return -1;
+  if (deque->size == deque->cap && deque_grow(deque, deque->cap << 1))
+    return -1;
+  SLOT(deque, deque->size) = element;
+  ++deque->size;
+  return 0;
+}
+
+void *deque_pop_back(Deque *deque) {
+  if (!deque_valid(deque)) {
+    return NULL;
+  } else if (deque->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  --deque->size;
+  return SLOT(deque, deque->size);
+}
+
+void *deque_back(const Deque *deque) {
+  if (!deque_valid(deque)) {
+    return NULL;
+  } else if (deque->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return SLOT(deque, deque->size - 1);
+}
+
+/* moves the front element to the back */
+int deque_rotate_forwards(Deque *deque) {
+  if (!deque_valid(deque)) return -1;
+  if (deque->size < 2) return 0;
+  void *front = deque->data[deque->head];
+  deque->head = (deque->head + 1) & (deque->cap - 1);
+  SLOT(deque, deque->size - 1) = front;
+  return 0;
+}
+
+/* moves the back element to the front */
+int deque_rotate_backwards(Deque *deque) {
+  if (!deque_valid(deque)) return -1;
+  if (deque->size < 2) return 0;
+  void *back = SLOT(deque, deque->size - 1);
+  deque->head = (deque->head - 1) & (deque->cap - 1);
+  deque->data[deque->head] = back;
+  return 0;
+}
+
+/* array functions */
+void *deque_get(const Deque *deque, size_t index) {
+  if (!deque_valid(deque)) {
+    return NULL;
+  } else if (index >= deque->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return NULL;
+  }
+  return SLOT(deque, index);
+}
+
+int deque_set(Deque *deque, void *element, size_t index) {
+  if (!deque_valid(deque)) {
+    return -1;
+  } else if (index >= deque->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+  if (deque->data_destroy)
+    DESTROY_DATA(deque->data_destroy, SLOT(deque, index));
+  SLOT(deque, index) = element;
+  return 0;
+}
+
+size_t deque_find(const Deque *deque, void *target) {
+  if (!deque_valid(deque) || !target) return -1;
+  size_t i;
+  for (i = 0; i < deque->size; ++i) {
+    void *element = SLOT(deque, i);
+    if (deque->data_compare ? deque->data_compare(target, element)
+                            : target == element)
+      return i;
+  }
+  return -1;
+}
+
+size_t deque_rfind(const Deque *deque, void *target) {
+  if (!deque_valid(deque) || !target) return -1;
+  size_t i;
+  for (i = deque->size; i > 0; --i) {
+    void *element = SLOT(deque, i - 1);
+    if (deque->data_compare ? deque->data_compare(target, element)
+                            : target == element)
+      return i - 1;
+  }
+  return -1;
+}
+
+void deque_foreach(Deque *deque, void (*fn)(void *)) {
+  if (!deque_valid(deque) || !fn) return;
+  size_t i;
+  for (i = 0; i < deque->size; ++i) fn(SLOT(deque, i));
+}
+
+/* status functions */
+size_t deque_size(const Deque *deque) {
+  if (!deque_valid(deque)) return 0;
+  return deque->size;
+}
+
+int deque_empty(const Deque *deque) {
+  if (!deque_valid(deque)) return 1;
+  return deque->size == 0;
+}
+
+int deque_status(const Deque *deque) {
+  if (!deque_valid(deque)) return BLIB_INVALID_STRUCT;
+  return last_status;
+}
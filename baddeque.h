@@ -0,0 +1,51 @@
+#ifndef __BADDEQUE_H__
+#define __BADDEQUE_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+#define BLIB_DEQUE_EMPTY \
+  { NULL, 0, 0, 0, NULL, NULL, NULL }
+
+/* An array-backed deque. The elements live in a ring buffer whose capacity is
+ * always a power of two, so pushing and popping at either end is O(1)
+ * amortized and allocates only when the buffer is full.
+ */
+typedef struct deque {
+  void **data;
+  size_t head;
+  size_t size;
+  size_t cap;
+  BlibDestroyer data_destroy;
+  BlibComparator data_compare;
+  const BlibAllocator *allocator;
+} Deque;
+
+int deque_init(Deque *deque, BlibDestroyer dest, BlibComparator comp);
+int deque_init_alloc(Deque *deque, BlibDestroyer dest, BlibComparator comp,
+                     const BlibAllocator *allocator);
+int deque_destroy(Deque *deque);
+int deque_clear(Deque *deque);
+int deque_reserve(Deque *deque, size_t cap);
+
+int deque_push_front(Deque *deque, void *element);
+void *deque_pop_front(Deque *deque);
+void *deque_front(const Deque *deque);
+
+int deque_push_back(Deque *deque, void *element);
+void *deque_pop_back(Deque *deque);
+void *deque_back(const Deque *deque);
+
+int deque_rotate_forwards(Deque *deque);
+int deque_rotate_backwards(Deque *deque);
+
+void *deque_get(const Deque *deque, size_t index);
+int deque_set(Deque *deque, void *element, size_t index);
+size_t deque_find(const Deque *deque, void *target);
+size_t deque_rfind(const Deque *deque, void *target);
+void deque_foreach(Deque *deque, void (*fn)(void *));
+
+size_t deque_size(const Deque *deque);
+int deque_empty(const Deque *deque);
+int deque_status(const Deque *deque);
+#endif
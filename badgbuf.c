@@ -0,0 +1,276 @@
+#include "badgbuf.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+
+#define GAP(BUF) ((BUF)->gap_end - (BUF)->gap_start)
+#define SIZE(BUF) ((BUF)->cap - GAP(BUF))
+#define SLOT(BUF, INDEX) \
+  ((BUF)->data + (INDEX) + ((INDEX) < (BUF)->gap_start ? 0 : GAP(BUF)))
+
+static BlibError last_status = BLIB_SUCCESS;
+
+/* internal functions */
+static int gbuf_valid(const GapBuffer *buf) {
+  if (buf == NULL || buf->cap == 0) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  } else if (buf->data == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return 0;
+  } else {
+    return 1;
+  }
+}
+
+/* makes the gap at least `needed` long, keeping it where it is */
+static int gbuf_reserve(GapBuffer *buf, size_t needed) {
+  if (GAP(buf) >= needed) {
+    return 0;
+  } else if (needed > (size_t)-1 / sizeof(void *) - SIZE(buf)) {
+    last_status = BLIB_INVALID_SIZE;
+    return -1;
+  }
+
+  size_t cap = buf->cap, tail = buf->cap - buf->gap_end;
+  while (cap - SIZE(buf) < needed) cap <<= 1;
+  void **new_data = blib_realloc(buf->allocator, buf->data,
+                                 sizeof(void *) * buf->cap,
+                                 sizeof(void *) * cap);
+  if (new_data == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  memmove(new_data + cap - tail, new_data + buf->gap_end,
+          sizeof(void *) * tail);
+  buf->data = new_data;
+  buf->gap_end = cap - tail;
+  buf->cap = cap;
+  return 0;
+}
+
+/* moves the gap so that it starts at index; only the elements between the
+ * old and new positions are copied
+ */
+static void gbuf_shift_gap(GapBuffer *buf, size_t index) {
+  if (index < buf->gap_start) {
+    size_t count = buf->gap_start - index;
+    memmove(buf->data + buf->gap_end - count, buf->data + index,
+            sizeof(void *) * count);
+    buf->gap_start -= count;
+    buf->gap_end -= count;
+  } else if (index > buf->gap_start) {
+    size_t count = index - buf->gap_start;
+    memmove(buf->data + buf->gap_start, buf->data + buf->gap_end,
+            sizeof(void *) * count);
+    buf->gap_start += count;
+    buf->gap_end += count;
+  }
+}
+
+/* destroys the `count` elements just after the gap and absorbs them */
+static void gbuf_absorb(GapBuffer *buf, size_t count, BlibDestroyer destroy) {
+  if (destroy) {
+    size_t i;
+    for (i = buf->gap_end; i < buf->gap_end + count; ++i)
+      if (buf->data[i]) DESTROY_DATA(destroy, buf->data[i]);
+  }
+  buf->gap_end += count;
+}
+
+/* external functions */
+int gbuf_init(GapBuffer *buf, size_t size) {
+  return gbuf_init_alloc(buf, size, NULL);
+}
+
+int gbuf_init_alloc(GapBuffer *buf, size_t size,
+                    const BlibAllocator *allocator) {
+  if (buf == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+
+  buf->cap = 8;
+  while (buf->cap <= size) buf->cap <<= 1;
+  buf->allocator = allocator;
+  buf->data = blib_alloc(allocator, sizeof(void *) * buf->cap);
+  if (buf->data == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  memset(buf->data, 0, sizeof(void *) * size);
+  buf->gap_start = size;
+  buf->gap_end = buf->cap;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int gbuf_destroy(GapBuffer *buf, BlibDestroyer destroy) {
+  if (buf == NULL)
+    return 0;
+  else if (!gbuf_valid(buf))
+    return -1;
+
+  gbuf_clear(buf, destroy);
+  blib_free(buf->allocator, buf->data, sizeof(void *) * buf->cap);
+  /* paranoid free */
+  memset(buf, 0, sizeof(GapBuffer));
+  return 0;
+}
+
+/* like alist_clear, the size is kept and the elements are set to NULL */
+int gbuf_clear(GapBuffer *buf, BlibDestroyer destroy) {
+  if (!gbuf_valid(buf)) return -1;
+
+  size_t i, size = SIZE(buf);
+  for (i = 0; i < size; ++i) {
+    void **slot = SLOT(buf, i);
+    if (*slot && destroy) DESTROY_DATA(destroy, *slot);
+    *slot = NULL;
+  }
+  return 0;
+}
+
+void *gbuf_get(const GapBuffer *buf, size_t index) {
+  if (!gbuf_valid(buf)) {
+    return NULL;
+  } else if (index >= SIZE(buf)) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return NULL;
+  } else {
+    void *ret = *SLOT(buf, index);
+    last_status = ret == NULL ? W_BLIB_NOT_FOUND : BLIB_SUCCESS;
+    return ret;
+  }
+}
+
+int gbuf_set(GapBuffer *buf, void *element, size_t index,
+             BlibDestroyer destroy) {
+  if (!gbuf_valid(buf)) {
+    return -1;
+  } else if (index >= SIZE(buf)) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+
+  void **slot = SLOT(buf, index);
+  if (*slot && destroy) DESTROY_DATA(destroy, *slot);
+  *slot = element;
+  return 0;
+}
+
+int gbuf_insert(GapBuffer *buf, void *element, size_t index) {
+  return gbuf_insert_range(buf, index, &element, 1);
+}
+
+int gbuf_insert_range(GapBuffer *buf, size_t index, void *const *elements,
+                      size_t count) {
+  if (!gbuf_valid(buf)) {
+    return -1;
+  } else if (index > SIZE(buf)) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  } else if (count == 0) {
+    return 0;
+  } else if (elements == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  } else if (gbuf_reserve(buf, count)) {
+    return -1;
+  }
+
+  gbuf_shift_gap(buf, index);
+  memcpy(buf->data + buf->gap_start, elements, sizeof(void *) * count);
+  buf->gap_start += count;
+  return 0;
+}
+
+int gbuf_delete(GapBuffer *buf, size_t index, BlibDestroyer destroy) {
+  return gbuf_erase_range(buf, index, index + 1, destroy);
+}
+
+int gbuf_erase_range(GapBuffer *buf, size_t start, size_t end,
+                     BlibDestroyer destroy) {
+  if (!gbuf_valid(buf)) {
+    return -1;
+  } else if (start > end || end > SIZE(buf)) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+
+  gbuf_shift_gap(buf, start);
+  gbuf_absorb(buf, end - start, destroy);
+  return 0;
+}
+
+/* edits are cheapest at the gap, so callers about to make a run of edits
+ * somewhere can move it there up front
+ */
+int gbuf_move_gap(GapBuffer *buf, size_t index) {
+  if (!gbuf_valid(buf)) {
+    return -1;
+  } else if (index > SIZE(buf)) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+
+  gbuf_shift_gap(buf, index);
+  return 0;
+}
+
+int gbuf_push(GapBuffer *buf, void *element) {
+  if (!gbuf_valid(buf)) return -1;
+  return gbuf_insert_range(buf, SIZE(buf), &element, 1);
+}
+
+int gbuf_pop(GapBuffer *buf, BlibDestroyer destroy) {
+  if (!gbuf_valid(buf)) {
+    return -1;
+  } else if (SIZE(buf) == 0) {
+    last_status = BLIB_EMPTY;
+    return -1;
+  }
+  return gbuf_erase_range(buf, SIZE(buf) - 1, SIZE(buf), destroy);
+}
+
+/* if compare is NULL, elements are compared by address */
+size_t gbuf_find(const GapBuffer *buf, void *target, BlibComparator compare) {
+  if (!gbuf_valid(buf)) return -1;
+
+  size_t i, size = SIZE(buf);
+  for (i = 0; i < size; ++i) {
+    void *element = *SLOT(buf, i);
+    if (element && (compare ? compare(target, element) : target == element))
+      return i;
+  }
+
+  last_status = W_BLIB_NOT_FOUND;
+  return size;
+}
+
+void gbuf_foreach(GapBuffer *buf, void (*fn)(void *)) {
+  if (!gbuf_valid(buf)) {
+    return;
+  } else if (!fn) {
+    last_status = BLIB_INVALID_STRUCT;
+    return;
+  }
+
+  size_t i;
+  for (i = 0; i < buf->gap_start; ++i)
+    if (buf->data[i]) fn(buf->data[i]);
+  for (i = buf->gap_end; i < buf->cap; ++i)
+    if (buf->data[i]) fn(buf->data[i]);
+}
+
+size_t gbuf_size(const GapBuffer *buf) { return SIZE(buf); }
+size_t gbuf_cap(const GapBuffer *buf) { return buf->cap; }
+int gbuf_empty(const GapBuffer *buf) { return SIZE(buf) == 0; }
+int gbuf_status(const GapBuffer *buf) {
+  (void)gbuf_valid(buf);
+  return last_status;
+}
@@ -0,0 +1,55 @@
+#ifndef __BADGBUF_H__
+#define __BADGBUF_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+#define BLIB_GBUF_EMPTY \
+  { NULL, 0, 0, 0, NULL }
+
+/* An ArrayList variant for edits clustered around a cursor. The unused part
+ * of the array is kept as a gap at the position of the last edit, elements
+ * before it stored at the front of `data` and elements after it at the back.
+ * Inserting or deleting at the gap is O(1); an edit elsewhere first moves
+ * the gap there, which only copies the elements in between. Indices are
+ * logical, so gbuf_get is still O(1).
+ *
+ * Unlike alist_insert and alist_delete, gbuf_insert and gbuf_delete shift the
+ * elements after index; gbuf_set overwrites in place.
+ */
+typedef struct gbuf {
+  void **data;
+  size_t gap_start;
+  size_t gap_end;
+  size_t cap;
+  const BlibAllocator *allocator;
+} GapBuffer;
+
+int gbuf_init(GapBuffer *buf, size_t size);
+int gbuf_init_alloc(GapBuffer *buf, size_t size,
+                    const BlibAllocator *allocator);
+int gbuf_destroy(GapBuffer *buf, BlibDestroyer destroyer);
+int gbuf_clear(GapBuffer *buf, BlibDestroyer destroyer);
+
+void *gbuf_get(const GapBuffer *buf, size_t index);
+int gbuf_set(GapBuffer *buf, void *data, size_t index,
+             BlibDestroyer destroyer);
+int gbuf_insert(GapBuffer *buf, void *data, size_t index);
+int gbuf_insert_range(GapBuffer *buf, size_t index, void *const *elements,
+                      size_t count);
+int gbuf_delete(GapBuffer *buf, size_t index, BlibDestroyer destroyer);
+int gbuf_erase_range(GapBuffer *buf, size_t start, size_t end,
+                     BlibDestroyer destroyer);
+int gbuf_move_gap(GapBuffer *buf, size_t index);
+
+int gbuf_push(GapBuffer *buf, void *data);
+int gbuf_pop(GapBuffer *buf, BlibDestroyer destroyer);
+
+size_t gbuf_find(const GapBuffer *buf, void *target, BlibComparator compare);
+void gbuf_foreach(GapBuffer *buf, void (*fn)(void *));
+
+size_t gbuf_size(const GapBuffer *buf);
+size_t gbuf_cap(const GapBuffer *buf);
+int gbuf_empty(const GapBuffer *buf);
+int gbuf_status(const GapBuffer *buf);
+#endif
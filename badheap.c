@@ -0,0 +1,320 @@
+#include "badheap.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalist.h"
+#include "badalloc.h"
+#include "badlib.h"
+
+static BlibError last_status = BLIB_SUCCESS;
+
+#define PARENT(HEAP, I) (((I) - 1) >> (HEAP)->shift)
+#define FIRST_CHILD(HEAP, I) (((I) << (HEAP)->shift) + 1)
+
+/* internal functions */
+static int heap_valid(const Heap *heap) {
+  if (heap == NULL || heap->cap == 0) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  } else if (heap->entries == NULL || heap->positions == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return 0;
+  }
+  return 1;
+}
+
+static int handle_valid(const Heap *heap, HeapHandle handle) {
+  if (handle >= heap->handles || heap->positions[handle] >= heap->size ||
+      heap->entries[heap->positions[handle]].handle != handle) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return 0;
+  }
+  return 1;
+}
+
+static int shift_of(unsigned arity, unsigned *shift) {
+  if (arity == 0) arity = BLIB_HEAP_ARITY;
+  if (arity < 2 || (arity & (arity - 1))) {
+    last_status = BLIB_INVALID_SIZE;
+    return -1;
+  }
+  for (*shift = 0; (1u << *shift) < arity; ++*shift) continue;
+  return 0;
+}
+
+static HeapHandle handle_acquire(Heap *heap) {
+  HeapHandle handle = heap->free_handle;
+  if (handle != BLIB_HEAP_NULL)
+    heap->free_handle = heap->positions[handle];
+  else
+    handle = heap->handles++;
+  return handle;
+}
+
+static void handle_release(Heap *heap, HeapHandle handle) {
+  heap->positions[handle] = heap->free_handle;
+  heap->free_handle = handle;
+}
+
+static void place(Heap *heap, size_t index, HeapEntry entry) {
+  heap->entries[index] = entry;
+  heap->positions[entry.handle] = index;
+}
+
+/* both sifts carry the entry in a hole instead of swapping at every level */
+static void sift_up(Heap *heap, size_t index, HeapEntry entry) {
+  while (index > 0) {
+    size_t parent = PARENT(heap, index);
+    if (heap->data_compare(entry.data, heap->entries[parent].data) >= 0) break;
+    place(heap, index, heap->entries[parent]);
+    index = parent;
+  }
+  place(heap, index, entry);
+}
+
+static void sift_down(Heap *heap, size_t index, HeapEntry entry) {
+  size_t arity = (size_t)1 << heap->shift;
+  for (;;) {
+    size_t child = FIRST_CHILD(heap, index), best, end;
+    if (child >= heap->size || child < index) break;
+    end = child + arity < heap->size ? child + arity : heap->size;
+    for (best = child++; child < end; ++child)
+      if (heap->data_compare(heap->entries[child].data,
+                             heap->entries[best].data) < 0)
+        best = child;
+    if (heap->data_compare(heap->entries[best].data, entry.data) >= 0) break;
+    place(heap, index, heap->entries[best]);
+    index = best;
+  }
+  place(heap, index, entry);
+}
+
+/* restores the heap around an entry put at index, which may need to move
+ * either way
+ */
+static void sift(Heap *heap, size_t index, HeapEntry entry) {
+  if (index > 0 &&
+      heap->data_compare(entry.data,
+                         heap->entries[PARENT(heap, index)].data) < 0)
+    sift_up(heap, index, entry);
+  else
+    sift_down(heap, index, entry);
+}
+
+/* takes out the entry at index, filling its place with the last one */
+static void *take(Heap *heap, size_t index) {
+  HeapEntry removed = heap->entries[index];
+  HeapEntry last = heap->entries[--heap->size];
+  handle_release(heap, removed.handle);
+  if (index < heap->size) sift(heap, index, last);
+  return removed.data;
+}
+
+/* external functions */
+int heap_init(Heap *heap, unsigned arity, BlibComparator compare,
+              BlibDestroyer destroy) {
+  return heap_init_alloc(heap, arity, compare, destroy, NULL);
+}
+
+int heap_init_alloc(Heap *heap, unsigned arity, BlibComparator compare,
+                    BlibDestroyer destroy, const BlibAllocator *allocator) {
+  if (heap == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+  memset(heap, 0, sizeof(Heap));
+  if (shift_of(arity, &heap->shift)) return -1;
+  if (compare == NULL) {
+    last_status = BLIB_COMPARE_ERROR;
+    return -1;
+  }
+
+  heap->cap = 16;
+  heap->allocator = allocator;
+  heap->entries = blib_alloc(allocator, sizeof(HeapEntry) * heap->cap);
+  heap->positions = blib_alloc(allocator, sizeof(HeapHandle) * heap->cap);
+  if (heap->entries == NULL || heap->positions == NULL) {
+    blib_free(allocator, heap->entries, sizeof(HeapEntry) * heap->cap);
+    blib_free(allocator, heap->positions, sizeof(HeapHandle) * heap->cap);
+    memset(heap, 0, sizeof(Heap));
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  heap->free_handle = BLIB_HEAP_NULL;
+  heap->data_compare = compare;
+  heap->data_destroy = destroy;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+/* Builds a heap from the non-NULL elements of list in O(n), by sifting down
+ * every parent from the last one up. The elements are moved rather than
+ * copied, so list is left empty; element i of the list gets handle i when
+ * the list has no holes.
+ */
+int heap_from_alist(Heap *heap, ArrayList *list, unsigned arity,
+                    BlibComparator compare, BlibDestroyer destroy) {
+  return heap_from_alist_alloc(heap, list, arity, compare, destroy, NULL);
+}
+
+int heap_from_alist_alloc(Heap *heap, ArrayList *list, unsigned arity,
+                          BlibComparator compare, BlibDestroyer destroy,
+                          const BlibAllocator *allocator) {
+  if (list == NULL || list->data == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+  if (heap_init_alloc(heap, arity, compare, destroy, allocator)) return -1;
+  if (heap_reserve(heap, list->count)) {
+    heap_destroy(heap);
+    return -1;
+  }
+
+  size_t i;
+  for (i = 0; i < list->size; ++i) {
+    if (list->data[i] == NULL) continue;
+    heap->entries[heap->size].data = list->data[i];
+    heap->entries[heap->size].handle = heap->size;
+    heap->positions[heap->size] = heap->size;
+    ++heap->size;
+  }
+  heap->handles = heap->size;
+  alist_erase_range(list, 0, list->size, NULL);
+
+  if (heap->size > 1)
+    for (i = PARENT(heap, heap->size - 1) + 1; i-- > 0;)
+      sift_down(heap, i, heap->entries[i]);
+  return 0;
+}
+
+int heap_destroy(Heap *heap) {
+  if (heap == NULL) return 0;
+  if (heap_clear(heap)) return -1;
+  blib_free(heap->allocator, heap->entries, sizeof(HeapEntry) * heap->cap);
+  blib_free(heap->allocator, heap->positions, sizeof(HeapHandle) * heap->cap);
+  /* paranoid free */
+  memset(heap, 0, sizeof(Heap));
+  return 0;
+}
+
+int heap_clear(Heap *heap) {
+  if (!heap_valid(heap)) return -1;
+  size_t i;
+  if (heap->data_destroy)
+    for (i = 0; i < heap->size; ++i)
+      DESTROY_DATA(heap->data_destroy, heap->entries[i].data);
+  heap->size = 0;
+  heap->handles = 0;
+  heap->free_handle = BLIB_HEAP_NULL;
+  return 0;
+}
+
+int heap_reserve(Heap *heap, size_t cap) {
+  if (!heap_valid(heap)) return -1;
+  if (cap <= heap->cap) return 0;
+
+  HeapEntry *entries =
+      blib_realloc(heap->allocator, heap->entries,
+                   sizeof(HeapEntry) * heap->cap, sizeof(HeapEntry) * cap);
+  if (entries == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  heap->entries = entries;
+  HeapHandle *positions =
+      blib_realloc(heap->allocator, heap->positions,
+                   sizeof(HeapHandle) * heap->cap, sizeof(HeapHandle) * cap);
+  if (positions == NULL) {
+    /* the sizes passed back to the allocator must match again */
+    entries = blib_realloc(heap->allocator, heap->entries,
+                           sizeof(HeapEntry) * cap,
+                           sizeof(HeapEntry) * heap->cap);
+    if (entries) heap->entries = entries;
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  heap->positions = positions;
+  heap->cap = cap;
+  return 0;
+}
+
+/* stores the new element's handle in handle if it is not NULL */
+int heap_push(Heap *heap, void *data, HeapHandle *handle) {
+  if (!heap_valid(heap)) return -1;
+  if (heap->size == heap->cap && heap_reserve(heap, heap->cap * 2)) return -1;
+
+  HeapEntry entry;
+  entry.data = data;
+  entry.handle = handle_acquire(heap);
+  sift_up(heap, heap->size++, entry);
+  if (handle) *handle = entry.handle;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+void *heap_peek(const Heap *heap) {
+  if (!heap_valid(heap)) {
+    return NULL;
+  } else if (heap->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return heap->entries[0].data;
+}
+
+void *heap_pop(Heap *heap) {
+  if (!heap_valid(heap)) {
+    return NULL;
+  } else if (heap->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return take(heap, 0);
+}
+
+/* Pops the top and pushes data with a single sift, which is what keeping
+ * the k largest of a stream needs: replace the top of a k-element heap
+ * whenever a larger element arrives. data takes over the top's handle.
+ */
+void *heap_replace_top(Heap *heap, void *data) {
+  if (!heap_valid(heap)) {
+    return NULL;
+  } else if (heap->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  HeapEntry entry = heap->entries[0];
+  void *ret = entry.data;
+  entry.data = data;
+  sift_down(heap, 0, entry);
+  return ret;
+}
+
+void *heap_get(const Heap *heap, HeapHandle handle) {
+  if (!heap_valid(heap) || !handle_valid(heap, handle)) return NULL;
+  return heap->entries[heap->positions[handle]].data;
+}
+
+/* restores the order after the priority of the element at handle changed,
+ * in either direction
+ */
+int heap_update(Heap *heap, HeapHandle handle) {
+  if (!heap_valid(heap) || !handle_valid(heap, handle)) return -1;
+  size_t index = heap->positions[handle];
+  sift(heap, index, heap->entries[index]);
+  return 0;
+}
+
+/* removes the element at handle without destroying it */
+void *heap_remove(Heap *heap, HeapHandle handle) {
+  if (!heap_valid(heap) || !handle_valid(heap, handle)) return NULL;
+  return take(heap, heap->positions[handle]);
+}
+
+size_t heap_size(const Heap *heap) { return heap->size; }
+int heap_empty(const Heap *heap) { return heap->size == 0; }
+int heap_status(const Heap *heap) {
+  (void)heap_valid(heap);
+  return last_status;
+}
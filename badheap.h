@@ -0,0 +1,72 @@
+#ifndef __BADHEAP_H__
+#define __BADHEAP_H__
+#include <stddef.h>
+
+#include "badalist.h"
+#include "badlib.h"
+
+/* arity used when heap_init is given 0 */
+#ifndef BLIB_HEAP_ARITY
+#define BLIB_HEAP_ARITY 4
+#endif
+
+/* A handle names an element for as long as it is in the heap; handles are
+ * reused once their element is popped or removed.
+ */
+typedef size_t HeapHandle;
+#define BLIB_HEAP_NULL ((HeapHandle)-1)
+
+typedef struct heap_entry {
+  void *data;
+  HeapHandle handle;
+} HeapEntry;
+
+/* A d-ary min-heap in a contiguous array: the element that compares lowest
+ * comes out first, and compare returns a negative, zero or positive value
+ * like strcmp. The arity must be a power of two so that moving between
+ * parents and children is a shift; 4 keeps the children of a node on one
+ * cache line and halves the height of a binary heap.
+ *
+ * `positions` maps each handle to the index of its entry, so an element can
+ * be found in O(1) to have its key changed or be removed; free handles are
+ * chained through it.
+ */
+typedef struct heap {
+  HeapEntry *entries;
+  HeapHandle *positions;
+  size_t size;
+  size_t cap;
+  size_t handles;
+  HeapHandle free_handle;
+  unsigned shift;
+  BlibComparator data_compare;
+  BlibDestroyer data_destroy;
+  const BlibAllocator *allocator;
+} Heap;
+
+int heap_init(Heap *heap, unsigned arity, BlibComparator compare,
+              BlibDestroyer destroy);
+int heap_init_alloc(Heap *heap, unsigned arity, BlibComparator compare,
+                    BlibDestroyer destroy, const BlibAllocator *allocator);
+int heap_from_alist(Heap *heap, ArrayList *list, unsigned arity,
+                    BlibComparator compare, BlibDestroyer destroy);
+int heap_from_alist_alloc(Heap *heap, ArrayList *list, unsigned arity,
+                          BlibComparator compare, BlibDestroyer destroy,
+                          const BlibAllocator *allocator);
+int heap_destroy(Heap *heap);
+int heap_clear(Heap *heap);
+int heap_reserve(Heap *heap, size_t cap);
+
+int heap_push(Heap *heap, void *data, HeapHandle *handle);
+void *heap_peek(const Heap *heap);
+void *heap_pop(Heap *heap);
+void *heap_replace_top(Heap *heap, void *data);
+
+void *heap_get(const Heap *heap, HeapHandle handle);
+int heap_update(Heap *heap, HeapHandle handle);
+void *heap_remove(Heap *heap, HeapHandle handle);
+
+size_t heap_size(const Heap *heap);
+int heap_empty(const Heap *heap);
+int heap_status(const Heap *heap);
+#endif
@@ -0,0 +1,242 @@
+#include "badilist.h"
+
+#include <stddef.h>
+
+#include "badlib.h"
+
+static BlibError last_status = BLIB_SUCCESS;
+
+/* internal functions */
+static int ilist_valid(const IntrusiveList *list) {
+  if (list == NULL || list->anchor.next == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  }
+  return 1;
+}
+
+static void link_between(IntrusiveList *list, ListLink *pred, ListLink *succ,
+                         ListLink *link) {
+  link->prev = pred;
+  link->next = succ;
+  pred->next = link;
+  succ->prev = link;
+  ++list->size;
+}
+
+static void link_remove(IntrusiveList *list, ListLink *link) {
+  link->prev->next = link->next;
+  link->next->prev = link->prev;
+  link->next = NULL;
+  link->prev = NULL;
+  --list->size;
+}
+
+/* links may only be in one list at a time */
+static int link_free(const ListLink *link) {
+  if (link == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return 0;
+  } else if (link->next || link->prev) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  }
+  return 1;
+}
+
+/* external functions */
+int ilist_init(IntrusiveList *list) {
+  if (list == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+  list->anchor.next = &list->anchor;
+  list->anchor.prev = &list->anchor;
+  list->size = 0;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+/* unlinks every element, passing each to fn if it is not NULL */
+int ilist_clear(IntrusiveList *list, void (*fn)(ListLink *)) {
+  if (!ilist_valid(list)) return -1;
+  while (list->anchor.next != &list->anchor) {
+    ListLink *link = list->anchor.next;
+    link_remove(list, link);
+    if (fn) fn(link);
+  }
+  return 0;
+}
+
+int ilist_push_front(IntrusiveList *list, ListLink *link) {
+  if (!ilist_valid(list) || !link_free(link)) return -1;
+  link_between(list, &list->anchor, list->anchor.next, link);
+  return 0;
+}
+
+ListLink *ilist_pop_front(IntrusiveList *list) {
+  if (!ilist_valid(list)) {
+    return NULL;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  ListLink *ret = list->anchor.next;
+  link_remove(list, ret);
+  return ret;
+}
+
+ListLink *ilist_front(const IntrusiveList *list) {
+  if (!ilist_valid(list)) {
+    return NULL;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return list->anchor.next;
+}
+
+int ilist_push_back(IntrusiveList *list, ListLink *link) {
+  if (!ilist_valid(list) || !link_free(link)) return -1;
+  link_between(list, list->anchor.prev, &list->anchor, link);
+  return 0;
+}
+
+ListLink *ilist_pop_back(IntrusiveList *list) {
+  if (!ilist_valid(list)) {
+    return NULL;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  ListLink *ret = list->anchor.prev;
+  link_remove(list, ret);
+  return ret;
+}
+
+ListLink *ilist_back(const IntrusiveList *list) {
+  if (!ilist_valid(list)) {
+    return NULL;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return list->anchor.prev;
+}
+
+/* moves the front element to the back */
+int ilist_rotate_forwards(IntrusiveList *list) {
+  if (!ilist_valid(list)) return -1;
+  if (list->size < 2) return 0;
+  ListLink *link = list->anchor.next;
+  link_remove(list, link);
+  link_between(list, list->anchor.prev, &list->anchor, link);
+  return 0;
+}
+
+/* moves the back element to the front */
+int ilist_rotate_backwards(IntrusiveList *list) {
+  if (!ilist_valid(list)) return -1;
+  if (list->size < 2) return 0;
+  ListLink *link = list->anchor.prev;
+  link_remove(list, link);
+  link_between(list, &list->anchor, list->anchor.next, link);
+  return 0;
+}
+
+/* where may be the anchor, in which case link goes at the back */
+int ilist_insert_before(IntrusiveList *list, ListLink *where, ListLink *link) {
+  if (!ilist_valid(list) || !link_free(link)) {
+    return -1;
+  } else if (where == NULL || where->prev == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+  link_between(list, where->prev, where, link);
+  return 0;
+}
+
+/* where may be the anchor, in which case link goes at the front */
+int ilist_insert_after(IntrusiveList *list, ListLink *where, ListLink *link) {
+  if (!ilist_valid(list) || !link_free(link)) {
+    return -1;
+  } else if (where == NULL || where->next == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+  link_between(list, where, where->next, link);
+  return 0;
+}
+
+/* O(1); link must be in list */
+int ilist_unlink(IntrusiveList *list, ListLink *link) {
+  if (!ilist_valid(list)) {
+    return -1;
+  } else if (link == NULL || link == &list->anchor || link->next == NULL) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+  link_remove(list, link);
+  return 0;
+}
+
+int ilist_linked(const ListLink *link) { return link && link->next != NULL; }
+
+/* fn may unlink the link it is given */
+void ilist_foreach(IntrusiveList *list, void (*fn)(ListLink *)) {
+  if (!ilist_valid(list) || !fn) return;
+  ListLink *link, *next;
+  ILIST_FOREACH(link, next, list) fn(link);
+}
+
+ListLink *ilist_begin(IntrusiveList *list) {
+  if (!ilist_valid(list)) return NULL;
+  return list->anchor.next;
+}
+
+ListLink *ilist_end(IntrusiveList *list) {
+  if (!ilist_valid(list)) return NULL;
+  return &list->anchor;
+}
+
+/* like liter_next, stepping onto the anchor is allowed but not past it,
+ * even when the walk starts there
+ */
+ListLink *ilist_next(const IntrusiveList *list, ListLink *link, size_t count) {
+  if (!ilist_valid(list) || link == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return NULL;
+  }
+  size_t i;
+  for (i = 0; i < count; ++i) {
+    if (link == &list->anchor) {
+      last_status = BLIB_OUT_OF_BOUNDS;
+      return NULL;
+    }
+    link = link->next;
+  }
+  return link;
+}
+
+ListLink *ilist_prev(const IntrusiveList *list, ListLink *link, size_t count) {
+  if (!ilist_valid(list) || link == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return NULL;
+  }
+  size_t i;
+  for (i = 0; i < count; ++i) {
+    if (link == &list->anchor && i > 0) {
+      last_status = BLIB_OUT_OF_BOUNDS;
+      return NULL;
+    }
+    link = link->prev;
+  }
+  return link;
+}
+
+size_t ilist_size(const IntrusiveList *list) { return list->size; }
+int ilist_empty(const IntrusiveList *list) { return list->size == 0; }
+int ilist_status(const IntrusiveList *list) {
+  (void)ilist_valid(list);
+  return last_status;
+}
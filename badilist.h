@@ -0,0 +1,75 @@
+#ifndef __BADILIST_H__
+#define __BADILIST_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+/* pointer to the struct of type TYPE whose member MEMBER is at PTR */
+#define BLIB_CONTAINER_OF(PTR, TYPE, MEMBER) \
+  ((TYPE *)((char *)(PTR) - offsetof(TYPE, MEMBER)))
+
+/* initializer for lists with static storage; the anchor has to point at
+ * itself, so the variable being initialized must be named
+ */
+#define BLIB_ILIST_INIT(LIST) \
+  { { &(LIST).anchor, &(LIST).anchor }, 0 }
+
+/* iterates LINK over every link in LIST; the current link may be unlinked in
+ * the body, since the next one is read before it runs
+ */
+#define ILIST_FOREACH(LINK, NEXT, LIST)                                   \
+  for ((LINK) = (LIST)->anchor.next, (NEXT) = (LINK)->next;               \
+       (LINK) != &(LIST)->anchor; (LINK) = (NEXT), (NEXT) = (LINK)->next)
+
+/* A link to embed in the objects stored in an IntrusiveList. Links that are
+ * not in a list have NULL pointers.
+ */
+typedef struct list_link {
+  struct list_link *next;
+  struct list_link *prev;
+} ListLink;
+
+/* An intrusive doubly linked list. Instead of allocating a Node that points
+ * to each element, the list threads through ListLinks embedded in the
+ * elements themselves, so it never allocates and an element can be unlinked
+ * in O(1) given only the element. Use BLIB_CONTAINER_OF to get from a link
+ * back to its object. Links are borrowed, not owned: the list never frees
+ * anything, and an object must be unlinked before it is freed.
+ */
+typedef struct ilist {
+  ListLink anchor;
+  size_t size;
+} IntrusiveList;
+
+int ilist_init(IntrusiveList *list);
+int ilist_clear(IntrusiveList *list, void (*fn)(ListLink *));
+
+int ilist_push_front(IntrusiveList *list, ListLink *link);
+ListLink *ilist_pop_front(IntrusiveList *list);
+ListLink *ilist_front(const IntrusiveList *list);
+
+int ilist_push_back(IntrusiveList *list, ListLink *link);
+ListLink *ilist_pop_back(IntrusiveList *list);
+ListLink *ilist_back(const IntrusiveList *list);
+
+int ilist_rotate_forwards(IntrusiveList *list);
+int ilist_rotate_backwards(IntrusiveList *list);
+
+int ilist_insert_before(IntrusiveList *list, ListLink *where, ListLink *link);
+int ilist_insert_after(IntrusiveList *list, ListLink *where, ListLink *link);
+int ilist_unlink(IntrusiveList *list, ListLink *link);
+int ilist_linked(const ListLink *link);
+void ilist_foreach(IntrusiveList *list, void (*fn)(ListLink *));
+
+/* iteration; the anchor returned by ilist_end is the position past either
+ * end, and is never passed to callbacks
+ */
+ListLink *ilist_begin(IntrusiveList *list);
+ListLink *ilist_end(IntrusiveList *list);
+ListLink *ilist_next(const IntrusiveList *list, ListLink *link, size_t count);
+ListLink *ilist_prev(const IntrusiveList *list, ListLink *link, size_t count);
+
+size_t ilist_size(const IntrusiveList *list);
+int ilist_empty(const IntrusiveList *list);
+int ilist_status(const IntrusiveList *list);
+#endif
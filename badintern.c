@@ -0,0 +1,153 @@
+#include "badintern.h"
+
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+#include "murmur3/murmur3.h"
+
+static BlibError last_status = BLIB_SUCCESS;
+
+/* The Set holds InternEntry pointers. Lookups pass an entry on the stack that
+ * points at the caller's bytes, so a string that is already interned is
+ * never copied. The anchors of the Set are NULL and reach the comparator too.
+ */
+static size_t entry_hash(const void *entry, size_t size) {
+  (void)size;
+  return ((const InternEntry *)entry)->hash;
+}
+
+static int entry_equal(void *e1, void *e2) {
+  const InternEntry *a = e1;
+  const InternEntry *b = e2;
+  if (!a || !b) return a == b;
+  return a->hash == b->hash && a->size == b->size &&
+         memcmp(a->bytes, b->bytes, a->size) == 0;
+}
+
+static const InternEntry *entry_of(const char *interned) {
+  return (const InternEntry *)interned - 1;
+}
+
+static int intern_valid(const InternTable *table) {
+  if (!table || !table->entries.buckets) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  }
+  return 1;
+}
+
+int intern_init(InternTable *table, size_t capacity) {
+  return intern_init_alloc(table, capacity, NULL);
+}
+
+int intern_init_alloc(InternTable *table, size_t capacity,
+                      const BlibAllocator *allocator) {
+  if (!table) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+
+  arena_init_alloc(&table->strings, BLIB_INTERN_CHUNK, allocator);
+  if (set_init_alloc(&table->entries, capacity ? capacity : 1, NULL,
+                     entry_equal, allocator) ||
+      set_set_hasher(&table->entries, entry_hash)) {
+    table->entries.buckets = NULL;
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int intern_destroy(InternTable *table) {
+  if (!intern_valid(table)) return -1;
+
+  /* the entries live in the arena, so the Set has nothing to destroy */
+  set_destroy(&table->entries);
+  arena_destroy(&table->strings);
+
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+const char *intern_lookup(InternTable *table, const void *bytes, size_t size) {
+  if (!intern_valid(table)) return NULL;
+  if (!bytes && size) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return NULL;
+  }
+
+  InternEntry probe;
+  probe.hash = 0;
+  MurmurHash3_x86_32(bytes, size, 0, &probe.hash);
+  probe.size = size;
+  probe.bytes = bytes;
+
+  InternEntry *found = set_get(&table->entries, &probe, sizeof(probe));
+  if (!found) {
+    last_status = W_BLIB_NOT_FOUND;
+    return NULL;
+  }
+
+  last_status = BLIB_SUCCESS;
+  return found->bytes;
+}
+
+const char *intern_bytes(InternTable *table, const void *bytes, size_t size) {
+  const char *interned = intern_lookup(table, bytes, size);
+  if (interned || last_status != W_BLIB_NOT_FOUND) return interned;
+
+  Set *entries = &table->entries;
+  /* keep chains short; a failed rehash only leaves them longer */
+  if (set_size(entries) >= 2 * entries->capacity)
+    set_rehash(entries, 2 * entries->capacity);
+
+  InternEntry *entry =
+      arena_alloc(&table->strings, sizeof(InternEntry) + size + 1);
+  if (!entry) {
+    last_status = BLIB_ALLOC_FAIL;
+    return NULL;
+  }
+  char *copy = (char *)(entry + 1);
+  if (size) memcpy(copy, bytes, size);
+  copy[size] = '\0';
+
+  entry->hash = 0;
+  MurmurHash3_x86_32(copy, size, 0, &entry->hash);
+  entry->size = size;
+  entry->bytes = copy;
+
+  if (set_insert(entries, entry, sizeof(*entry))) {
+    last_status = BLIB_ALLOC_FAIL;
+    return NULL;
+  }
+
+  last_status = BLIB_SUCCESS;
+  return copy;
+}
+
+const char *intern_cstr(InternTable *table, const char *str) {
+  if (!str) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return NULL;
+  }
+  return intern_bytes(table, str, strlen(str));
+}
+
+size_t intern_hash(const char *interned) { return entry_of(interned)->hash; }
+size_t intern_size(const char *interned) { return entry_of(interned)->size; }
+
+size_t intern_hasher(const void *interned, size_t size) {
+  (void)size;
+  return entry_of(interned)->hash;
+}
+
+int intern_equal(void *i1, void *i2) { return i1 == i2; }
+
+size_t intern_count(InternTable *table) { return set_size(&table->entries); }
+int intern_status(const InternTable *table) {
+  (void)intern_valid(table);
+  return last_status;
+}
@@ -0,0 +1,58 @@
+#ifndef __BADINTERN_H__
+#define __BADINTERN_H__
+#include <stddef.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+#include "badset.h"
+
+/* bytes in each block of the arena */
+#ifndef BLIB_INTERN_CHUNK
+#define BLIB_INTERN_CHUNK 65536
+#endif
+
+/* The record stored in the arena just in front of every interned string,
+ * which is kept right after it with a terminating NUL. The hash is the same
+ * MurmurHash3 that Map and Set use by default.
+ */
+typedef struct intern_entry {
+  size_t hash;
+  size_t size;
+  const char *bytes;
+} InternEntry;
+
+/* A table that stores each distinct byte string once and hands out a
+ * canonical pointer to it. Interning equal strings returns the same pointer,
+ * which stays valid until the table is destroyed, so interned strings can be
+ * compared by address. The Set of entries is grown as strings are added.
+ * The strings live in an Arena, so a table must not be copied or moved while
+ * in use.
+ */
+typedef struct intern_table {
+  Set entries;
+  Arena strings;
+} InternTable;
+
+int intern_init(InternTable *table, size_t capacity);
+int intern_init_alloc(InternTable *table, size_t capacity,
+                      const BlibAllocator *allocator);
+int intern_destroy(InternTable *table);
+
+const char *intern_bytes(InternTable *table, const void *bytes, size_t size);
+const char *intern_cstr(InternTable *table, const char *str);
+const char *intern_lookup(InternTable *table, const void *bytes, size_t size);
+
+/* only valid for pointers returned by an InternTable */
+size_t intern_hash(const char *interned);
+size_t intern_size(const char *interned);
+
+/* Hooks for a Map or Set keyed by interned strings: pass intern_equal as the
+ * comparator and intern_hasher to map_set_hasher or set_set_hasher, and the
+ * keys are never hashed or compared byte by byte again.
+ */
+size_t intern_hasher(const void *interned, size_t size);
+int intern_equal(void *i1, void *i2);
+
+size_t intern_count(InternTable *table);
+int intern_status(const InternTable *table);
+#endif
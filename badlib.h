@@ -1,5 +1,6 @@
 #ifndef __BADLIB_H__
 #define __BADLIB_H__
+#include <stddef.h>
 
 #ifdef UNIT_TESTING
 extern void _test_free(void* const ptr, const char* file, const int line);
@@ -9,6 +10,13 @@ extern void _test_free(void* const ptr, const char* file, const int line);
 #define DESTROY_DATA(FN, DATA) ((FN)(DATA))
 #endif
 
+/* the concurrent containers pad apart fields written by different threads so
+ * that they do not share a cache line
+ */
+#ifndef BLIB_CACHE_LINE
+#define BLIB_CACHE_LINE 64
+#endif
+
 typedef enum badlib_error {
   BLIB_SUCCESS,
   BLIB_ALLOC_FAIL,
@@ -26,4 +34,17 @@ typedef enum badlib_error {
 
 typedef void (*BlibDestroyer)(void*);
 typedef int (*BlibComparator)(void*, void*);
+typedef size_t (*BlibHasher)(const void*, size_t);
+
+/* Where a container gets its memory. Sizes are passed back on reallocate and
+ * release, so allocators need not record them; see badalloc.h. Containers
+ * keep a pointer to one, and use malloc when it is NULL.
+ */
+typedef struct blib_allocator {
+  void* (*allocate)(void* context, size_t size);
+  void* (*reallocate)(void* context, void* ptr, size_t old_size,
+                      size_t new_size);
+  void (*release)(void* context, void* ptr, size_t size);
+  void* context;
+} BlibAllocator;
 #endif
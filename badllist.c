@@ -4,6 +4,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 
+#include "badalloc.h"
 #include "badlib.h"
 
 static BlibError last_status = BLIB_SUCCESS;
@@ -19,13 +20,18 @@ static int llist_valid(const LinkedList *list) {
   return 1;
 }
 static int node_init(LinkedList *list, Node *pred, Node *succ, void *element) {
-  Node *new_node = malloc(sizeof(Node));
+  Node *new_node = blib_alloc(list->allocator, sizeof(Node));
+  if (new_node == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return 1;
+  }
   new_node->data = element;
   new_node->next = succ;
   new_node->prev = pred;
   pred->next = new_node;
   succ->prev = new_node;
   ++list->size;
+  list->finger = NULL;
   return 0;
 }
 
@@ -37,24 +43,155 @@ static int node_destroy(LinkedList *list, Node *node, void **wants_data) {
   } else if (list->data_destroy) {
     DESTROY_DATA(list->data_destroy, node->data);
   }
-  free(node);
+  blib_free(list->allocator, node, sizeof(Node));
   --list->size;
+  list->finger = NULL;
   return 0;
 }
 
-static Node *node_at(const LinkedList *list, size_t index) {
-  size_t current_index = 0;
-  Node *current_node = list->anchor->next;
-  while (current_index < index) {
-    current_node = current_node->next;
-    ++current_index;
+/* Links a new node for each of the elements before succ. All of the nodes
+ * are allocated before any are linked, so on failure the list is unchanged.
+ */
+static int nodes_init(LinkedList *list, Node *succ, void *const *elements,
+                      size_t count) {
+  Node *first = NULL, *last = NULL;
+  size_t i;
+  for (i = 0; i < count; ++i) {
+    Node *node = blib_alloc(list->allocator, sizeof(Node));
+    if (node == NULL) {
+      while (first) {
+        Node *next = first->next;
+        blib_free(list->allocator, first, sizeof(Node));
+        first = next;
+      }
+      last_status = BLIB_ALLOC_FAIL;
+      return 1;
+    }
+    node->data = elements[i];
+    node->next = NULL;
+    node->prev = last;
+    if (last)
+      last->next = node;
+    else
+      first = node;
+    last = node;
+  }
+
+  if (count == 0) return 0;
+  first->prev = succ->prev;
+  last->next = succ;
+  succ->prev->next = first;
+  succ->prev = last;
+  list->size += count;
+  list->finger = NULL;
+  return 0;
+}
+
+/* moves the `count` nodes from first to last, inclusive, out of src and
+ * before succ in dest
+ */
+static void nodes_move(LinkedList *src, Node *first, Node *last, size_t count,
+                       LinkedList *dest, Node *succ) {
+  first->prev->next = last->next;
+  last->next->prev = first->prev;
+  src->size -= count;
+  src->finger = NULL;
+
+  first->prev = succ->prev;
+  last->next = succ;
+  succ->prev->next = first;
+  succ->prev = last;
+  dest->size += count;
+  dest->finger = NULL;
+}
+
+/* walks from whichever of the head, the anchor and the finger is nearest;
+ * index may be list->size, which is the anchor
+ */
+static Node *node_at(LinkedList *list, size_t index) {
+  Node *node = list->anchor->next;
+  size_t current = 0, distance = index;
+
+  if (list->size - index < distance) {
+    node = list->anchor;
+    current = list->size;
+    distance = list->size - index;
+  }
+  if (list->finger) {
+    size_t finger = list->finger_index;
+    size_t from_finger = index > finger ? index - finger : finger - index;
+    if (from_finger < distance) {
+      node = list->finger;
+      current = finger;
+    }
   }
-  return current_node;
+
+  for (; current < index; ++current) node = node->next;
+  for (; current > index; --current) node = node->prev;
+  if (node != list->anchor) {
+    list->finger = node;
+    list->finger_index = index;
+  }
+  return node;
+}
+
+/* Detaches the run at the front of *rest and returns it, leaving *rest at the
+ * node after it. Strictly descending runs are reversed, which keeps the sort
+ * stable since no two of their elements compare equal.
+ */
+static Node *run_take(Node **rest, int (*compare)(void *, void *)) {
+  Node *head = *rest, *next = head->next;
+  if (next && compare(head->data, next->data) > 0) {
+    head->next = NULL;
+    while (next && compare(head->data, next->data) > 0) {
+      Node *after = next->next;
+      next->next = head;
+      head = next;
+      next = after;
+    }
+    *rest = next;
+    return head;
+  }
+
+  Node *tail = head;
+  while (tail->next && compare(tail->data, tail->next->data) <= 0)
+    tail = tail->next;
+  *rest = tail->next;
+  tail->next = NULL;
+  return head;
+}
+
+/* merges two sorted runs, preferring left on ties, and sets *tail to the last
+ * node of the result
+ */
+static Node *run_merge(Node *left, Node *right, int (*compare)(void *, void *),
+                       Node **tail) {
+  Node head, *last = &head;
+  while (left && right) {
+    if (compare(right->data, left->data) < 0) {
+      last->next = right;
+      right = right->next;
+    } else {
+      last->next = left;
+      left = left->next;
+    }
+    last = last->next;
+  }
+  last->next = left ? left : right;
+  while (last->next) last = last->next;
+  *tail = last;
+  return head.next;
 }
 
 /* initializer/destructor */
 int llist_init(LinkedList *list, BlibDestroyer dest, BlibComparator comp) {
-  list->anchor = malloc(sizeof(Node));
+  return llist_init_alloc(list, dest, comp, NULL);
+}
+
+int llist_init_alloc(LinkedList *list, BlibDestroyer dest, BlibComparator comp,
+                     const BlibAllocator *allocator) {
+  list->allocator = allocator;
+  list->anchor = blib_alloc(allocator, sizeof(Node));
   if (list->anchor == NULL) return 1;
   list->anchor->next = list->anchor;
   list->anchor->prev = list->anchor;
@@ -62,6 +199,8 @@ int llist_init(LinkedList *list, BlibDestroyer dest, BlibComparator comp) {
   list->data_destroy = dest;
   list->data_compare = comp;
   list->size = 0;
+  list->finger = NULL;
+  list->finger_index = 0;
   return 0;
 }
 
@@ -76,7 +215,7 @@ int llist_destroy(LinkedList *list) {
   while (list->anchor->next != list->anchor) {
     node_destroy(list, list->anchor->next, NULL);
   }
-  free(list->anchor);
+  blib_free(list->allocator, list->anchor, sizeof(Node));
   /* paranoid free */
   list->anchor = NULL;
   return 0;
@@ -101,12 +240,13 @@ int llist_clear(LinkedList *list) {
  */
 int llist_copy(LinkedList *dest, const LinkedList *src) {
   if (!dest || !llist_valid(src)) return -1;
-  int status = llist_init(dest, NULL, src->data_compare);
+  int status =
+      llist_init_alloc(dest, NULL, src->data_compare, src->allocator);
   if (status) return status;
 
-  size_t i;
-  for (i = 0; i < llist_size(src); ++i) {
-    status = llist_push_back(dest, llist_get(src, i));
+  Node *node;
+  for (node = src->anchor->next; node != src->anchor; node = node->next) {
+    status = llist_push_back(dest, node->data);
     if (status) return status;
   }
   return 0;
@@ -161,6 +301,7 @@ void *llist_back(const LinkedList *list) {
 int llist_rotate_forwards(LinkedList *list) {
   if (!llist_valid(list)) return 1;
   if (list->anchor->next == list->anchor->prev) return 0;
+  list->finger = NULL;
   Node *temp = list->anchor->next;
   temp->next = list->anchor;
   temp->prev = list->anchor->prev;
@@ -174,6 +315,7 @@ int llist_rotate_forwards(LinkedList *list) {
 int llist_rotate_backwards(LinkedList *list) {
   if (!llist_valid(list)) return 1;
   if (list->anchor->next == list->anchor->prev) return 0;
+  list->finger = NULL;
   Node *temp = list->anchor->prev;
   temp->next = list->anchor->next;
   temp->prev = list->anchor;
@@ -185,7 +327,7 @@ int llist_rotate_backwards(LinkedList *list) {
 }
 
 /* array functions */
-void *llist_get(const LinkedList *list, size_t index) {
+void *llist_get(LinkedList *list, size_t index) {
   if (!llist_valid(list)) {
     return NULL;
   } else if (index >= list->size) {
@@ -234,11 +376,11 @@ void *llist_extract(LinkedList *list, size_t index) {
 size_t llist_find(const LinkedList *list, void *target) {
   if (!llist_valid(list) || !target) return -1;
   size_t i;
-  for (i = 0; i < list->size; ++i) {
-    void *element = llist_get(list, i);
+  Node *node = list->anchor->next;
+  for (i = 0; node != list->anchor; ++i, node = node->next) {
     if (list->data_compare) {
-      if ((list->data_compare)(target, element)) return i;
-    } else if (target == element) {
+      if ((list->data_compare)(target, node->data)) return i;
+    } else if (target == node->data) {
       return i;
     }
   }
@@ -247,12 +389,13 @@ size_t llist_find(const LinkedList *list, void *target) {
 
 size_t llist_rfind(const LinkedList *list, void *target) {
   if (!llist_valid(list) || !target) return -1;
-  size_t i, list_size = llist_size(list);
-  for (i = 1; i <= list_size; ++i) {
-    void *element = llist_get(list, list_size - i);
+  size_t i;
+  Node *node = list->anchor->prev;
+  for (i = list->size; node != list->anchor; node = node->prev) {
+    --i;
     if (list->data_compare) {
-      if ((list->data_compare)(target, element)) return i;
-    } else if (target == element) {
+      if ((list->data_compare)(target, node->data)) return i;
+    } else if (target == node->data) {
       return i;
     }
   }
@@ -261,31 +404,137 @@ size_t llist_rfind(const LinkedList *list, void *target) {
 
 void llist_foreach(LinkedList *list, void (*fn)(void *)) {
   if (!llist_valid(list) || !fn) return;
-  size_t i;
-  for (i = 0; i < list->size; ++i) {
-    void *element = llist_get(list, i);
-    (fn)(element);
-  }
+  Node *node;
+  for (node = list->anchor->next; node != list->anchor; node = node->next)
+    (fn)(node->data);
 }
 
-/* compare function assumed to be equivalent to <= */
+/* Stable, allocation-free natural merge sort. compare returns a negative
+ * number, zero or a positive number like the comparator passed to qsort.
+ * Each pass merges pairs of adjacent runs, so a list that is already sorted,
+ * or sorted in reverse, takes a single pass.
+ */
 int llist_sort(LinkedList *list, int (*compare)(void *, void *)) {
-  size_t i;
-  for (i = 0; i < list->size; ++i) {
-    size_t max_index = i;
-    void *max = llist_extract(list, max_index);
-    size_t j;
-    for (j = i; j < list->size; ++j) {
-      if ((compare)(max, llist_get(list, j))) {
-        max_index = j;
-        /* do not remove from list; just hold onto it for comparisons */
-        max = llist_get(list, max_index);
-      }
+  if (!llist_valid(list)) {
+    return 1;
+  } else if (!compare) {
+    last_status = BLIB_COMPARE_ERROR;
+    return 1;
+  } else if (list->size < 2) {
+    return 0;
+  }
+
+  /* work on the nodes as a NULL-terminated singly linked list */
+  Node *first = list->anchor->next;
+  list->anchor->prev->next = NULL;
+  size_t runs;
+  do {
+    Node *rest = first, **link = &first;
+    for (runs = 0; rest; ++runs) {
+      Node *tail, *left = run_take(&rest, compare), *right = NULL;
+      if (rest) right = run_take(&rest, compare);
+      *link = run_merge(left, right, compare, &tail);
+      link = &tail->next;
     }
-    /* maximum must be extracted */
-    max = llist_extract(list, max_index);
-    llist_push_front(list, max);
+  } while (runs > 1);
+
+  /* restore the prev pointers and close the circle */
+  Node *prev = list->anchor, *node;
+  for (node = first; node; prev = node, node = node->next) {
+    node->prev = prev;
+    prev->next = node;
   }
+  prev->next = list->anchor;
+  list->anchor->prev = prev;
+  list->finger = NULL;
+  return 0;
+}
+
+/* bulk functions */
+int llist_push_back_array(LinkedList *list, void *const *elements,
+                          size_t count) {
+  if (!llist_valid(list)) {
+    return 1;
+  } else if (elements == NULL && count) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return 1;
+  }
+  return nodes_init(list, list->anchor, elements, count);
+}
+
+/* Moves every element of src before where, in O(1). src is left empty but
+ * still initialized. Nodes only move between lists that share an allocator.
+ */
+int llist_splice(ListIter *where, LinkedList *src) {
+  if (where == NULL || !llist_valid(where->list) || !llist_valid(src)) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 1;
+  } else if (where->list == src || where->list->allocator != src->allocator) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 1;
+  } else if (src->size == 0) {
+    return 0;
+  }
+  nodes_move(src, src->anchor->next, src->anchor->prev, src->size,
+             where->list, where->node);
+  return 0;
+}
+
+/* Moves [first, end) before where, which may be in the same list but not
+ * inside the range. The range is walked once, both to check it and to keep
+ * the sizes right, so end must follow first without crossing the anchor.
+ */
+int llist_splice_range(ListIter *where, ListIter *first, ListIter *end) {
+  if (where == NULL || first == NULL || end == NULL ||
+      !llist_valid(where->list) || !llist_valid(first->list) ||
+      first->list != end->list ||
+      first->list->allocator != where->list->allocator) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 1;
+  } else if (first->node == end->node) {
+    return 0;
+  }
+
+  LinkedList *src = first->list;
+  size_t count = 0;
+  Node *node;
+  for (node = first->node; node != end->node; node = node->next, ++count) {
+    if (node == src->anchor || node == where->node) {
+      last_status = BLIB_OUT_OF_BOUNDS;
+      return 1;
+    }
+  }
+  nodes_move(src, first->node, end->node->prev, count, where->list,
+             where->node);
+  return 0;
+}
+
+/* moves every element of src to the back of dest */
+int llist_concat(LinkedList *dest, LinkedList *src) {
+  ListIter where;
+  if (liter_init_end(&where, dest)) return 1;
+  return llist_splice(&where, src);
+}
+
+/* Initializes out with the same destroyer, comparator and allocator as list,
+ * and moves the elements from index onwards into it.
+ */
+int llist_split_at(LinkedList *list, size_t index, LinkedList *out) {
+  if (!llist_valid(list) || out == NULL || out == list) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 1;
+  } else if (index > list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return 1;
+  } else if (llist_init_alloc(out, list->data_destroy, list->data_compare,
+                              list->allocator)) {
+    last_status = BLIB_ALLOC_FAIL;
+    return 1;
+  } else if (index == list->size) {
+    return 0;
+  }
+  nodes_move(list, node_at(list, index), list->anchor->prev,
+             list->size - index, out, out->anchor);
   return 0;
 }
 
@@ -312,50 +561,92 @@ int llist_status(const LinkedList *list) {
   return last_status;
 }
 
-ListIter *llist_iter_begin(LinkedList *list) {
-  if (!llist_valid(list)) {
+/* Iterators are plain values; these fill in one provided by the caller, such
+ * as a local variable, so iterating never allocates.
+ */
+int liter_init_begin(ListIter *iter, LinkedList *list) {
+  if (iter == NULL || !llist_valid(list)) {
     last_status = BLIB_INVALID_STRUCT;
-    return NULL;
+    return -1;
+  }
+  iter->list = list;
+  iter->node = list->anchor->next;
+  return 0;
+}
+
+int liter_init_end(ListIter *iter, LinkedList *list) {
+  if (iter == NULL || !llist_valid(list)) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
   }
+  iter->list = list;
+  iter->node = list->anchor;
+  return 0;
+}
+
+int liter_init_last(ListIter *iter, LinkedList *list) {
+  if (iter == NULL || !llist_valid(list)) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+  iter->list = list;
+  iter->node = list->anchor->prev;
+  return 0;
+}
+
+int liter_init_at(ListIter *iter, LinkedList *list, size_t index) {
+  if (iter == NULL || !llist_valid(list)) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  } else if (index > list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+  iter->list = list;
+  iter->node = node_at(list, index);
+  return 0;
+}
+
+/* the functions below return iterators that the caller must free */
+static ListIter *liter_alloc(void) {
   ListIter *ret = malloc(sizeof(ListIter));
-  ret->list = list;
-  ret->node = list->anchor->next;
+  if (ret == NULL) last_status = BLIB_ALLOC_FAIL;
+  return ret;
+}
+
+ListIter *llist_iter_begin(LinkedList *list) {
+  ListIter *ret = liter_alloc();
+  if (ret && liter_init_begin(ret, list)) {
+    free(ret);
+    return NULL;
+  }
   return ret;
 }
 
 ListIter *llist_iter_end(LinkedList *list) {
-  if (!llist_valid(list)) {
-    last_status = BLIB_INVALID_STRUCT;
+  ListIter *ret = liter_alloc();
+  if (ret && liter_init_end(ret, list)) {
+    free(ret);
     return NULL;
   }
-  ListIter *ret = malloc(sizeof(ListIter));
-  ret->list = list;
-  ret->node = list->anchor;
   return ret;
 }
 
 ListIter *llist_iter_last(LinkedList *list) {
-  if (!llist_valid(list)) {
-    last_status = BLIB_INVALID_STRUCT;
+  ListIter *ret = liter_alloc();
+  if (ret && liter_init_last(ret, list)) {
+    free(ret);
     return NULL;
   }
-  ListIter *ret = malloc(sizeof(ListIter));
-  ret->list = list;
-  ret->node = list->anchor->prev;
   return ret;
 }
 
 ListIter *llist_iter_at(LinkedList *list, size_t index) {
-  if (!llist_valid(list)) {
-    last_status = BLIB_INVALID_STRUCT;
-    return NULL;
-  } else if (index > list->size) {
-    last_status = BLIB_OUT_OF_BOUNDS;
+  ListIter *ret = liter_alloc();
+  if (ret && liter_init_at(ret, list, index)) {
+    free(ret);
     return NULL;
   }
-  ListIter *ret = malloc(sizeof(ListIter));
-  ret->list = list;
-  ret->node = node_at(list, index);
   return ret;
 }
 
@@ -393,9 +684,30 @@ int liter_delete(ListIter *iter) {
   return node_destroy(iter->list, to_delete, NULL);
 }
 
+/* inserts the elements before iter, which keeps pointing at the same node */
+int liter_insert_array(ListIter *iter, void *const *elements, size_t count) {
+  if (iter == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  } else if (elements == NULL && count) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+  return nodes_init(iter->list, iter->node, elements, count) ? -1 : 0;
+}
+
 int liter_push_back(ListIter *iter, ListIter **out, size_t count, ...) {
-  ListIter *current = (out != NULL && *out == iter) ? iter : liter_copy(iter);
-  if (current == NULL) return -1;
+  ListIter local, *current;
+  if (iter == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  } else if (out == NULL) {
+    local = *iter;
+    current = &local;
+  } else {
+    current = *out == iter ? iter : liter_copy(iter);
+    if (current == NULL) return -1;
+  }
   va_list args;
   va_start(args, count);
   size_t i;
@@ -405,33 +717,29 @@ int liter_push_back(ListIter *iter, ListIter **out, size_t count, ...) {
         node_init(current->list, current->node, current->node->next, element);
     if (status) {
       va_end(args);
-      if (current != iter) free(current);
+      if (current != iter && current != &local) free(current);
       if (out != NULL && *out != iter) *out = NULL;
       return status;
     }
     current->node = current->node->next;
   }
   va_end(args);
-  if (out != NULL)
-    *out = current;
-  else
-    free(current);
+  if (out != NULL) *out = current;
   return 0;
 }
 
 int liter_push_front(ListIter *iter, ListIter **out, size_t count, ...) {
-  ListIter *ins_loc;
-  if (out == NULL) {
-    ins_loc = iter;
-  } else if (*out != iter) {
-    *out = liter_prev(iter, 1);
-    if (*out == NULL) return liter_status(iter);
-    ins_loc = iter;
-  } else {
-    int status = liter_advance(iter, -1);
-    if (status) return status;
-    ins_loc = liter_next(iter, 1);
-    if (ins_loc == NULL) return liter_status(iter);
+  ListIter local, *ins_loc = iter;
+  if (iter == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  } else if (out != NULL && *out != iter) {
+    *out = liter_copy(iter);
+    if (*out == NULL) return -1;
+  } else if (out != NULL) {
+    /* iter itself is the output, so insert through a copy */
+    local = *iter;
+    ins_loc = &local;
   }
   va_list args;
   va_start(args, count);
@@ -442,9 +750,7 @@ int liter_push_front(ListIter *iter, ListIter **out, size_t count, ...) {
         node_init(ins_loc->list, ins_loc->node->prev, ins_loc->node, element);
     if (status) {
       va_end(args);
-      if (ins_loc != iter) {
-        free(ins_loc);
-      } else if (out != NULL) {
+      if (out != NULL && *out != iter) {
         free(*out);
         *out = NULL;
       }
@@ -452,16 +758,11 @@ int liter_push_front(ListIter *iter, ListIter **out, size_t count, ...) {
     }
   }
   va_end(args);
-  if (ins_loc != iter) free(ins_loc);
   if (out != NULL) {
-    int status = liter_advance(*out, 1);
-    if (status) {
-      if (*out != iter) {
-        free(*out);
-        *out = NULL;
-      }
-      return status;
-    }
+    /* the first inserted node, found without stepping off the anchor */
+    Node *first = ins_loc->node;
+    for (i = 0; i < count; ++i) first = first->prev;
+    (*out)->node = first;
   }
   return 0;
 }
@@ -483,7 +784,8 @@ int liter_advance(ListIter *iter, ptrdiff_t count) {
     }
   } else {
     for (i = 0; i < count; ++i) {
-      if (iter->node == iter->list->anchor && i > 0) {
+      /* the end is past the last element; nothing follows it */
+      if (iter->node == iter->list->anchor) {
         last_status = BLIB_OUT_OF_BOUNDS;
         return -1;
       } else {
@@ -494,45 +796,43 @@ int liter_advance(ListIter *iter, ptrdiff_t count) {
   return 0;
 }
 
-ListIter *liter_next(ListIter *iter, size_t count) {
+/* single steps in place; equivalent to liter_advance by 1 and -1 */
+int liter_inc(ListIter *iter) {
   if (iter == NULL) {
     last_status = BLIB_INVALID_STRUCT;
-    return NULL;
-  }
-  Node *next = iter->node;
-  size_t i;
-  for (i = 0; i < count; ++i) {
-    if (next == iter->list->anchor && i > 0) {
-      last_status = BLIB_OUT_OF_BOUNDS;
-      return NULL;
-    } else {
-      next = next->next;
-    }
+    return -1;
+  } else if (iter->node == iter->list->anchor) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
   }
-  ListIter *ret = malloc(sizeof(ListIter));
-  ret->list = iter->list;
-  ret->node = next;
-  return ret;
+  iter->node = iter->node->next;
+  return 0;
 }
 
-ListIter *liter_prev(ListIter *iter, size_t count) {
+int liter_dec(ListIter *iter) {
   if (iter == NULL) {
     last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+  iter->node = iter->node->prev;
+  return 0;
+}
+
+ListIter *liter_next(ListIter *iter, size_t count) {
+  ListIter *ret = liter_copy(iter);
+  if (ret && liter_advance(ret, count)) {
+    free(ret);
     return NULL;
   }
-  Node *prev = iter->node;
-  size_t i;
-  for (i = 0; i < count; ++i) {
-    if (prev->prev == iter->list->anchor && i > 0) {
-      last_status = BLIB_OUT_OF_BOUNDS;
-      return NULL;
-    } else {
-      prev = prev->prev;
-    }
+  return ret;
+}
+
+ListIter *liter_prev(ListIter *iter, size_t count) {
+  ListIter *ret = liter_copy(iter);
+  if (ret && liter_advance(ret, -(ptrdiff_t)count)) {
+    free(ret);
+    return NULL;
   }
-  ListIter *ret = malloc(sizeof(ListIter));
-  ret->list = iter->list;
-  ret->node = prev;
   return ret;
 }
 
@@ -564,6 +864,7 @@ ListIter *liter_insert(ListIter *iter, size_t count, ...) {
 int liter_move_range(ListIter *start, ListIter *end, ListIter *where) {
   if (!start || !end || !where) return -1;
   if (start->list != where->list || end->list != where->list) return -1;
+  where->list->finger = NULL;
   start->node->prev->next = end->node->next;
   end->node->next->prev = start->node->prev;
   start->node->prev = where->node;
@@ -578,8 +879,8 @@ ListIter *liter_copy(ListIter *iter) {
     last_status = BLIB_INVALID_STRUCT;
     return NULL;
   }
-  ListIter *ret = malloc(sizeof(ListIter));
-  *ret = *iter;
+  ListIter *ret = liter_alloc();
+  if (ret) *ret = *iter;
   return ret;
 }
 
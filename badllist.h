@@ -5,7 +5,7 @@
 #include "badlib.h"
 
 #define BLIB_LLIST_EMPTY \
-  { NULL, NULL, NULL, 0 }
+  { NULL, NULL, NULL, 0, NULL, 0, NULL }
 
 typedef struct node {
   struct node *next;
@@ -13,11 +13,20 @@ typedef struct node {
   void *data;
 } Node;
 
+/* `finger` caches the node most recently reached by index, so that indexed
+ * access near the previous one does not walk from either end. It is cleared
+ * by anything that adds, removes or reorders nodes. Since even llist_get
+ * moves it, indexed reads write the list and must not run concurrently with
+ * any other access, including other reads.
+ */
 typedef struct llist {
   Node *anchor;
   BlibDestroyer data_destroy;
   BlibComparator data_compare;
   size_t size;
+  Node *finger;
+  size_t finger_index;
+  const BlibAllocator *allocator;
 } LinkedList;
 
 typedef struct llist_iter {
@@ -26,6 +35,8 @@ typedef struct llist_iter {
 } ListIter;
 
 int llist_init(LinkedList *list, BlibDestroyer dest, BlibComparator comp);
+int llist_init_alloc(LinkedList *list, BlibDestroyer dest, BlibComparator comp,
+                     const BlibAllocator *allocator);
 int llist_destroy(LinkedList *list);
 int llist_clear(LinkedList *list);
 int llist_copy(LinkedList *dest, const LinkedList *src);
@@ -41,7 +52,7 @@ void *llist_back(const LinkedList *list);
 int llist_rotate_forwards(LinkedList *list);
 int llist_rotate_backwards(LinkedList *list);
 
-void *llist_get(const LinkedList *list, size_t index);
+void *llist_get(LinkedList *list, size_t index);
 int llist_insert(LinkedList *list, void *element, size_t index);
 int llist_delete(LinkedList *list, size_t index);
 void *llist_extract(LinkedList *list, size_t index);
@@ -50,10 +61,24 @@ size_t llist_rfind(const LinkedList *list, void *target);
 void llist_foreach(LinkedList *list, void (*fn)(void *));
 int llist_sort(LinkedList *list, int (*compare)(void *, void *));
 
+int llist_push_back_array(LinkedList *list, void *const *elements,
+                          size_t count);
+int llist_splice(ListIter *where, LinkedList *src);
+int llist_splice_range(ListIter *where, ListIter *first, ListIter *end);
+int llist_concat(LinkedList *dest, LinkedList *src);
+int llist_split_at(LinkedList *list, size_t index, LinkedList *out);
+
 size_t llist_size(const LinkedList *list);
 int llist_empty(const LinkedList *list);
 int llist_status(const LinkedList *list);
 
+int liter_init_begin(ListIter *iter, LinkedList *list);
+int liter_init_end(ListIter *iter, LinkedList *list);
+int liter_init_last(ListIter *iter, LinkedList *list);
+int liter_init_at(ListIter *iter, LinkedList *list, size_t index);
+int liter_inc(ListIter *iter);
+int liter_dec(ListIter *iter);
+
 ListIter *llist_iter_begin(LinkedList *list);
 ListIter *llist_iter_end(LinkedList *list);
 ListIter *llist_iter_last(LinkedList *list);
@@ -61,6 +86,7 @@ ListIter *llist_iter_at(LinkedList *list, size_t index);
 int liter_ins_before(ListIter *iter, void *data);
 int liter_ins_after(ListIter *iter, void *data);
 int liter_delete(ListIter *iter);
+int liter_insert_array(ListIter *iter, void *const *elements, size_t count);
 int liter_push_back(ListIter *iter, ListIter **out, size_t count, ...);
 int liter_push_front(ListIter *iter, ListIter **out, size_t count, ...);
 int liter_advance(ListIter *iter, ptrdiff_t count);
@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <stdlib.h>
 
+#include "badalloc.h"
 #include "murmur3/murmur3.h"
 
 static BlibError last_status = BLIB_SUCCESS;
@@ -12,11 +13,30 @@ static BlibError last_status = BLIB_SUCCESS;
  */
 static int default_comp(void *k1, void *k2) { return k1 == k2; }
 
+/* MurmurHash3 over the bytes of the key, used unless the user sets a hasher */
+static size_t default_hash(const void *key, size_t key_size) {
+  size_t hash = 0;
+  MurmurHash3_x86_32(key, key_size, 0, &hash);
+  return hash;
+}
+
 int map_init(Map *map, size_t bucket_count, BlibDestroyer key_dest,
              BlibDestroyer value_dest, BlibComparator key_comp) {
+  return map_init_alloc(map, bucket_count, key_dest, value_dest, key_comp,
+                        NULL);
+}
+
+int map_init_alloc(Map *map, size_t bucket_count, BlibDestroyer key_dest,
+                   BlibDestroyer value_dest, BlibComparator key_comp,
+                   const BlibAllocator *allocator) {
   if (!map || bucket_count < 1) return 1;
 
-  map->buckets = malloc(bucket_count * sizeof(MapBucket));
+  map->allocator = allocator;
+  map->buckets = blib_alloc(allocator, bucket_count * sizeof(MapBucket));
+  if (!map->buckets) {
+    last_status = BLIB_ALLOC_FAIL;
+    return 1;
+  }
   size_t i;
   for (i = 0; i < bucket_count; ++i) {
     /* As a consequence of using NULL as the key for the anchors, the user may
@@ -33,6 +53,7 @@ int map_init(Map *map, size_t bucket_count, BlibDestroyer key_dest,
   map->key_destroy = key_dest;
   map->value_destroy = value_dest;
   map->key_compare = key_comp ? key_comp : default_comp;
+  map->key_hash = default_hash;
   return 0;
 }
 
@@ -48,7 +69,8 @@ int map_destroy(Map *map) {
     }
   }
 
-  free(map->buckets);
+  blib_free(map->allocator, map->buckets,
+            map->bucket_count * sizeof(MapBucket));
   /* paranoid free */
   map->buckets = NULL;
   return 0;
@@ -72,9 +94,7 @@ int map_clear(Map *map) {
 void *map_get(const Map *map, void *key, size_t key_size) {
   if (!map || !map->buckets || !key) return NULL;
 
-  size_t hash = 0;
-  MurmurHash3_x86_32(key, key_size, 0, &hash);
-  hash = hash % map->bucket_count;
+  size_t hash = (map->key_hash)(key, key_size) % map->bucket_count;
   MapBucket *current = map->buckets[hash].next;
 
   while (current != (map->buckets + hash) &&
@@ -89,9 +109,7 @@ void *map_get(const Map *map, void *key, size_t key_size) {
 int map_insert(Map *map, void *key, size_t key_size, void *value) {
   if (!map || !map->buckets || !key) return 1;
 
-  size_t hash = 0;
-  MurmurHash3_x86_32(key, key_size, 0, &hash);
-  hash = hash % map->bucket_count;
+  size_t hash = (map->key_hash)(key, key_size) % map->bucket_count;
 
   if ((map->key_compare)(map->buckets[hash].key, key)) {
     /* the anchor's value may not be modified */
@@ -110,7 +128,11 @@ int map_insert(Map *map, void *key, size_t key_size, void *value) {
     prev->next->value = value;
   } else {
     /* insert new bucket */
-    MapBucket *new_bucket = malloc(sizeof(MapBucket));
+    MapBucket *new_bucket = blib_alloc(map->allocator, sizeof(MapBucket));
+    if (!new_bucket) {
+      last_status = BLIB_ALLOC_FAIL;
+      return 1;
+    }
     new_bucket->key = key;
     new_bucket->value = value;
     new_bucket->key_size = key_size;
@@ -125,9 +147,7 @@ int map_insert(Map *map, void *key, size_t key_size, void *value) {
 int map_delete(Map *map, void *key, size_t key_size) {
   if (!map || !map->buckets || !key) return 1;
 
-  size_t hash = 0;
-  MurmurHash3_x86_32(key, key_size, 0, &hash);
-  hash = hash % map->bucket_count;
+  size_t hash = (map->key_hash)(key, key_size) % map->bucket_count;
 
   MapBucket *prev = map->buckets + hash;
   while (prev->next != (map->buckets + hash) &&
@@ -144,7 +164,7 @@ int map_delete(Map *map, void *key, size_t key_size) {
     if (map->key_destroy) DESTROY_DATA(map->key_destroy, to_free->key);
     if (map->value_destroy) DESTROY_DATA(map->value_destroy, to_free->value);
 
-    free(to_free);
+    blib_free(map->allocator, to_free, sizeof(MapBucket));
     --(map->entry_count);
   }
   return 0;
@@ -153,9 +173,7 @@ int map_delete(Map *map, void *key, size_t key_size) {
 int map_find(const Map *map, void *key, size_t key_size, size_t *out) {
   if (!map || !map->buckets || !key || !out) return 0;
 
-  size_t hash = 0;
-  MurmurHash3_x86_32(key, key_size, 0, &hash);
-  hash = hash % map->bucket_count;
+  size_t hash = (map->key_hash)(key, key_size) % map->bucket_count;
   MapBucket *current = map->buckets[hash].next;
 
   size_t i = 0;
@@ -257,6 +275,22 @@ int map_foreach_pair(Map *map, void (*fn)(void *, void *)) {
   return 0;
 }
 
+int map_set_hasher(Map *map, BlibHasher key_hash) {
+  if (!map) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return 1;
+  }
+  /* the entries already stored were placed by the old hash */
+  if (map->entry_count) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 1;
+  }
+
+  map->key_hash = key_hash ? key_hash : default_hash;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
 size_t map_size(const Map *map) { return map->entry_count; }
 int map_empty(const Map *map) { return map->entry_count == 0; }
 int map_status(const Map *map) {
@@ -6,7 +6,7 @@
 #include "badlib.h"
 
 #define BLIB_MAP_EMPTY \
-  { NULL, 0, 0, NULL, NULL, NULL }
+  { NULL, 0, 0, NULL, NULL, NULL, NULL, NULL }
 
 typedef struct map_pair {
   void *key;
@@ -27,10 +27,15 @@ typedef struct map {
   BlibDestroyer key_destroy;
   BlibDestroyer value_destroy;
   BlibComparator key_compare;
+  BlibHasher key_hash;
+  const BlibAllocator *allocator;
 } Map;
 
 int map_init(Map *map, size_t bucket_count, BlibDestroyer key_dest,
              BlibDestroyer value_dest, BlibComparator key_comp);
+int map_init_alloc(Map *map, size_t bucket_count, BlibDestroyer key_dest,
+                   BlibDestroyer value_dest, BlibComparator key_comp,
+                   const BlibAllocator *allocator);
 int map_destroy(Map *map);
 int map_clear(Map *map);
 
@@ -42,6 +47,11 @@ int map_keys(const Map *map, ArrayList *out);
 int map_values(const Map *map, ArrayList *out);
 int map_pairs(const Map *map, ArrayList *out);
 
+/* Replaces MurmurHash3 as the hash of the keys, or restores it when key_hash
+ * is NULL. Only allowed while the map is empty.
+ */
+int map_set_hasher(Map *map, BlibHasher key_hash);
+
 int map_foreach_key(Map *map, void (*fn)(void *));
 int map_foreach_value(Map *map, void (*fn)(void *));
 int map_foreach_pair(Map *map, void (*fn)(void *, void *));
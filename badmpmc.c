@@ -0,0 +1,304 @@
+#include "badmpmc.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+
+#ifndef __GNUC__
+#error "badmpmc.c requires the GCC __atomic builtins"
+#endif
+
+#define LOAD(PTR, ORDER) __atomic_load_n((PTR), __ATOMIC_##ORDER)
+#define STORE(PTR, VAL, ORDER) __atomic_store_n((PTR), (VAL), __ATOMIC_##ORDER)
+#define CAS(PTR, EXPECTED, DESIRED, ORDER)                      \
+  __atomic_compare_exchange_n((PTR), (EXPECTED), (DESIRED), 1, \
+                              __ATOMIC_##ORDER, __ATOMIC_RELAXED)
+
+/* bounded queue */
+int mpmc_init(MpmcQueue *queue, size_t cap) {
+  return mpmc_init_alloc(queue, cap, NULL);
+}
+
+int mpmc_init_alloc(MpmcQueue *queue, size_t cap,
+                    const BlibAllocator *allocator) {
+  if (queue == NULL || cap == 0 || cap > ((size_t)-1 >> 1)) return -1;
+
+  size_t i, real_cap = 2;
+  while (real_cap < cap) real_cap <<= 1;
+  memset(queue, 0, sizeof(MpmcQueue));
+  queue->allocator = allocator;
+  queue->cells = blib_alloc(allocator, sizeof(MpmcCell) * real_cap);
+  if (queue->cells == NULL) return -1;
+  for (i = 0; i < real_cap; ++i) {
+    queue->cells[i].sequence = i;
+    queue->cells[i].data = NULL;
+  }
+  queue->mask = real_cap - 1;
+  return 0;
+}
+
+int mpmc_destroy(MpmcQueue *queue, BlibDestroyer destroy) {
+  if (queue == NULL) return 0;
+  if (queue->cells == NULL) return -1;
+
+  void *element;
+  while ((element = mpmc_pop_front(queue)))
+    if (destroy) DESTROY_DATA(destroy, element);
+  blib_free(queue->allocator, queue->cells,
+            sizeof(MpmcCell) * (queue->mask + 1));
+  /* paranoid free */
+  memset(queue, 0, sizeof(MpmcQueue));
+  return 0;
+}
+
+/* A cell is free for the producer at pos when its sequence equals pos, and
+ * holds an element for the consumer at pos when it equals pos + 1. Consuming
+ * advances it by a full lap, to the next pos at which it can be written.
+ */
+int mpmc_push_back(MpmcQueue *queue, void *element) {
+  if (element == NULL) return -1;
+
+  MpmcCell *cell;
+  size_t pos = LOAD(&queue->enqueue_pos, RELAXED);
+  for (;;) {
+    cell = queue->cells + (pos & queue->mask);
+    ptrdiff_t diff = (ptrdiff_t)(LOAD(&cell->sequence, ACQUIRE) - pos);
+    if (diff == 0) {
+      if (CAS(&queue->enqueue_pos, &pos, pos + 1, RELAXED)) break;
+    } else if (diff < 0) {
+      /* the consumer a lap behind has not emptied this cell: full */
+      return -1;
+    } else {
+      pos = LOAD(&queue->enqueue_pos, RELAXED);
+    }
+  }
+
+  cell->data = element;
+  STORE(&cell->sequence, pos + 1, RELEASE);
+  return 0;
+}
+
+void *mpmc_pop_front(MpmcQueue *queue) {
+  MpmcCell *cell;
+  size_t pos = LOAD(&queue->dequeue_pos, RELAXED);
+  for (;;) {
+    cell = queue->cells + (pos & queue->mask);
+    ptrdiff_t diff = (ptrdiff_t)(LOAD(&cell->sequence, ACQUIRE) - (pos + 1));
+    if (diff == 0) {
+      if (CAS(&queue->dequeue_pos, &pos, pos + 1, RELAXED)) break;
+    } else if (diff < 0) {
+      /* no producer has filled this cell yet: empty */
+      return NULL;
+    } else {
+      pos = LOAD(&queue->dequeue_pos, RELAXED);
+    }
+  }
+
+  void *element = cell->data;
+  STORE(&cell->sequence, pos + queue->mask + 1, RELEASE);
+  return element;
+}
+
+/* only a snapshot while other threads are using the queue */
+size_t mpmc_size(const MpmcQueue *queue) {
+  size_t dequeued = LOAD(&queue->dequeue_pos, RELAXED);
+  size_t enqueued = LOAD(&queue->enqueue_pos, RELAXED);
+  return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+size_t mpmc_cap(const MpmcQueue *queue) { return queue->mask + 1; }
+
+/* hazard pointers */
+static MsqHazard *hazard_acquire(MsQueue *queue) {
+  MsqHazard *rec;
+  for (rec = LOAD(&queue->hazards, ACQUIRE); rec; rec = rec->next) {
+    int idle = 0;
+    if (!LOAD(&rec->active, RELAXED) && CAS(&rec->active, &idle, 1, ACQUIRE))
+      return rec;
+  }
+
+  /* every record is busy, so publish a new one; records are never removed */
+  rec = calloc(1, sizeof(MsqHazard));
+  if (rec == NULL) return NULL;
+  rec->active = 1;
+  rec->next = LOAD(&queue->hazards, RELAXED);
+  while (!CAS(&queue->hazards, &rec->next, rec, RELEASE)) continue;
+  return rec;
+}
+
+static void hazard_release(MsqHazard *rec) {
+  STORE(&rec->hazard[0], NULL, RELEASE);
+  STORE(&rec->hazard[1], NULL, RELEASE);
+  STORE(&rec->active, 0, RELEASE);
+}
+
+/* sets a hazard pointer to whatever *src holds and returns it, once the
+ * value is known to have been protected before it could be retired
+ */
+static MsqNode *hazard_protect(MsqHazard *rec, int index, MsqNode **src) {
+  MsqNode *node = LOAD(src, ACQUIRE);
+  for (;;) {
+    STORE(&rec->hazard[index], node, SEQ_CST);
+    MsqNode *again = LOAD(src, SEQ_CST);
+    if (again == node) return node;
+    node = again;
+  }
+}
+
+static int compare_pointers(const void *a, const void *b) {
+  const char *x = *(void *const *)a, *y = *(void *const *)b;
+  return x < y ? -1 : x > y;
+}
+
+/* Frees every node retired through rec that no hazard pointer refers to.
+ * Records are only ever prepended, so both walks follow one snapshot of the
+ * list and count the same records. One published after the snapshot cannot
+ * protect a node that was already unlinked, as hazard_protect rechecks it.
+ */
+static void hazard_scan(MsQueue *queue, MsqHazard *rec) {
+  MsqHazard *head = LOAD(&queue->hazards, ACQUIRE), *other;
+  size_t i, kept = 0, count = 0, cap = 0;
+  for (other = head; other; other = other->next) cap += 2;
+  void **protected = malloc(sizeof(void *) * cap);
+  if (protected == NULL) return;
+
+  for (other = head; other; other = other->next) {
+    for (i = 0; i < 2; ++i) {
+      void *hazard = LOAD(&other->hazard[i], SEQ_CST);
+      if (hazard) protected[count++] = hazard;
+    }
+  }
+  qsort(protected, count, sizeof(void *), compare_pointers);
+
+  for (i = 0; i < rec->retired_count; ++i) {
+    MsqNode *node = rec->retired[i];
+    if (bsearch(&node, protected, count, sizeof(void *), compare_pointers))
+      rec->retired[kept++] = node;
+    else
+      free(node);
+  }
+  rec->retired_count = kept;
+  free(protected);
+}
+
+static void hazard_retire(MsQueue *queue, MsqHazard *rec, MsqNode *node) {
+  if (rec->retired_count == rec->retired_cap) {
+    hazard_scan(queue, rec);
+    if (rec->retired_count * 2 >= rec->retired_cap) {
+      size_t cap = rec->retired_cap ? rec->retired_cap * 2 : 64;
+      MsqNode **retired = realloc(rec->retired, sizeof(MsqNode *) * cap);
+      /* without room to defer it, the node can only be leaked */
+      if (retired == NULL && rec->retired_count == rec->retired_cap) return;
+      if (retired) {
+        rec->retired = retired;
+        rec->retired_cap = cap;
+      }
+    }
+  }
+  rec->retired[rec->retired_count++] = node;
+}
+
+/* unbounded queue; head is always a dummy node, and the element at the front
+ * of the queue is in the node after it
+ */
+int msq_init(MsQueue *queue) {
+  if (queue == NULL) return -1;
+  memset(queue, 0, sizeof(MsQueue));
+  MsqNode *dummy = malloc(sizeof(MsqNode));
+  if (dummy == NULL) return -1;
+  dummy->next = NULL;
+  dummy->data = NULL;
+  queue->head = queue->tail = dummy;
+  return 0;
+}
+
+int msq_destroy(MsQueue *queue, BlibDestroyer destroy) {
+  if (queue == NULL) return 0;
+  if (queue->head == NULL) return -1;
+
+  MsqNode *node = queue->head;
+  while (node) {
+    MsqNode *next = node->next;
+    if (next && next->data && destroy) DESTROY_DATA(destroy, next->data);
+    free(node);
+    node = next;
+  }
+  MsqHazard *rec = queue->hazards;
+  while (rec) {
+    MsqHazard *next = rec->next;
+    size_t i;
+    for (i = 0; i < rec->retired_count; ++i) free(rec->retired[i]);
+    free(rec->retired);
+    free(rec);
+    rec = next;
+  }
+  /* paranoid free */
+  memset(queue, 0, sizeof(MsQueue));
+  return 0;
+}
+
+int msq_push_back(MsQueue *queue, void *element) {
+  if (element == NULL) return -1;
+  MsqNode *node = malloc(sizeof(MsqNode));
+  if (node == NULL) return -1;
+  node->data = element;
+  node->next = NULL;
+  MsqHazard *rec = hazard_acquire(queue);
+  if (rec == NULL) {
+    free(node);
+    return -1;
+  }
+
+  for (;;) {
+    MsqNode *tail = hazard_protect(rec, 0, &queue->tail);
+    MsqNode *next = LOAD(&tail->next, ACQUIRE);
+    if (tail != LOAD(&queue->tail, ACQUIRE)) continue;
+    if (next) {
+      /* another push linked its node but has not swung the tail yet */
+      CAS(&queue->tail, &tail, next, RELEASE);
+    } else if (CAS(&tail->next, &next, node, RELEASE)) {
+      CAS(&queue->tail, &tail, node, RELEASE);
+      break;
+    }
+  }
+  hazard_release(rec);
+  return 0;
+}
+
+void *msq_pop_front(MsQueue *queue) {
+  MsqHazard *rec = hazard_acquire(queue);
+  if (rec == NULL) return NULL;
+
+  void *element = NULL;
+  for (;;) {
+    MsqNode *head = hazard_protect(rec, 0, &queue->head);
+    MsqNode *tail = LOAD(&queue->tail, ACQUIRE);
+    MsqNode *next = hazard_protect(rec, 1, &head->next);
+    if (head != LOAD(&queue->head, SEQ_CST)) continue;
+    if (next == NULL) break;
+    if (head == tail) {
+      CAS(&queue->tail, &tail, next, RELEASE);
+      continue;
+    }
+    element = next->data;
+    if (CAS(&queue->head, &head, next, ACQ_REL)) {
+      /* next is the new dummy; the old one may still be read by others */
+      hazard_retire(queue, rec, head);
+      break;
+    }
+  }
+  hazard_release(rec);
+  return element;
+}
+
+int msq_empty(MsQueue *queue) {
+  MsqHazard *rec = hazard_acquire(queue);
+  if (rec == NULL) return -1;
+  MsqNode *head = hazard_protect(rec, 0, &queue->head);
+  int empty = LOAD(&head->next, ACQUIRE) == NULL;
+  hazard_release(rec);
+  return empty;
+}
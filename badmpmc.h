@@ -0,0 +1,80 @@
+#ifndef __BADMPMC_H__
+#define __BADMPMC_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+/* Both queues below may be pushed to and popped from by any number of
+ * threads at once without locks. They store non-NULL pointers only, since
+ * the pop functions return NULL when the queue is empty. Initialization and
+ * destruction are not thread safe. Failures are reported only through return
+ * values: a status shared between threads would be meaningless.
+ */
+
+typedef struct mpmc_cell {
+  size_t sequence;
+  void *data;
+} MpmcCell;
+
+/* Bounded queue on a ring of cells, after Dmitry Vyukov's design. Each cell
+ * carries a sequence number that says whether it is ready to be written or
+ * read at a given position, so producers and consumers only contend on the
+ * position they claim with a single compare-and-swap.
+ */
+typedef struct mpmc {
+  MpmcCell *cells;
+  size_t mask;
+  const BlibAllocator *allocator;
+  char pad0[BLIB_CACHE_LINE];
+  size_t enqueue_pos;
+  char pad1[BLIB_CACHE_LINE];
+  size_t dequeue_pos;
+  char pad2[BLIB_CACHE_LINE];
+} MpmcQueue;
+
+int mpmc_init(MpmcQueue *queue, size_t cap);
+int mpmc_init_alloc(MpmcQueue *queue, size_t cap,
+                    const BlibAllocator *allocator);
+int mpmc_destroy(MpmcQueue *queue, BlibDestroyer destroyer);
+int mpmc_push_back(MpmcQueue *queue, void *element);
+void *mpmc_pop_front(MpmcQueue *queue);
+size_t mpmc_size(const MpmcQueue *queue);
+size_t mpmc_cap(const MpmcQueue *queue);
+
+typedef struct msq_node {
+  struct msq_node *next;
+  void *data;
+} MsqNode;
+
+/* a set of hazard pointers; threads claim one for the duration of each
+ * operation, and the retired nodes it holds are freed once no hazard pointer
+ * refers to them
+ */
+typedef struct msq_hazard {
+  struct msq_hazard *next;
+  int active;
+  void *hazard[2];
+  MsqNode **retired;
+  size_t retired_count;
+  size_t retired_cap;
+} MsqHazard;
+
+/* Unbounded Michael-Scott queue. Nodes removed by one thread may still be
+ * read by another, so they are retired and only freed once no hazard pointer
+ * protects them. Nodes are allocated by every thread at once, so they always
+ * come from malloc rather than a BlibAllocator.
+ */
+typedef struct msq {
+  MsqNode *head;
+  char pad0[BLIB_CACHE_LINE];
+  MsqNode *tail;
+  char pad1[BLIB_CACHE_LINE];
+  MsqHazard *hazards;
+} MsQueue;
+
+int msq_init(MsQueue *queue);
+int msq_destroy(MsQueue *queue, BlibDestroyer destroyer);
+int msq_push_back(MsQueue *queue, void *element);
+void *msq_pop_front(MsQueue *queue);
+int msq_empty(MsQueue *queue);
+#endif
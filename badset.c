@@ -2,6 +2,7 @@
 
 #include <stdlib.h>
 
+#include "badalloc.h"
 #include "murmur3/murmur3.h"
 
 /* simple comparison function used as a placeholder when the user does not
@@ -9,11 +10,28 @@
  */
 static int default_comp(void *e1, void *e2) { return e1 == e2; }
 
+/* MurmurHash3 over the bytes of the element, used unless the user sets a
+ * hasher
+ */
+static size_t default_hash(const void *element, size_t element_size) {
+  size_t hash = 0;
+  MurmurHash3_x86_32(element, element_size, 0, &hash);
+  return hash;
+}
+
 int set_init(Set *set, size_t capacity, BlibDestroyer element_dest,
              BlibComparator element_comp) {
-  if (!set) return 1;
+  return set_init_alloc(set, capacity, element_dest, element_comp, NULL);
+}
+
+int set_init_alloc(Set *set, size_t capacity, BlibDestroyer element_dest,
+                   BlibComparator element_comp,
+                   const BlibAllocator *allocator) {
+  if (!set || capacity < 1) return 1;
 
-  set->buckets = malloc(capacity * sizeof(SetBucket));
+  set->allocator = allocator;
+  set->buckets = blib_alloc(allocator, capacity * sizeof(SetBucket));
+  if (!set->buckets) return 1;
   size_t i;
   for (i = 0; i < capacity; ++i) {
     /* As a consequence of using NULL as the element for the anchors, the user
@@ -28,6 +46,7 @@ int set_init(Set *set, size_t capacity, BlibDestroyer element_dest,
   set->length = 0;
   set->element_destroy = element_dest;
   set->element_compare = element_comp ? element_comp : default_comp;
+  set->element_hash = default_hash;
   return 0;
 }
 
@@ -44,16 +63,16 @@ int set_destroy(Set *set) {
     }
   }
 
-  free(set->buckets);
+  blib_free(set->allocator, set->buckets, set->capacity * sizeof(SetBucket));
+  /* paranoid free */
+  set->buckets = NULL;
   return 0;
 }
 
 void *set_get(Set *set, void *element, size_t element_size) {
   if (!set || !(set->buckets) || !element) return NULL;
 
-  size_t hash = 0;
-  MurmurHash3_x86_32(element, element_size, 0, &hash);
-  hash = hash % set->capacity;
+  size_t hash = (set->element_hash)(element, element_size) % set->capacity;
   SetBucket *current = set->buckets[hash].next;
 
   while (current != (set->buckets + hash) &&
@@ -68,9 +87,7 @@ void *set_get(Set *set, void *element, size_t element_size) {
 int set_insert(Set *set, void *element, size_t element_size) {
   if (!set || !(set->buckets) || !element) return 1;
 
-  size_t hash = 0;
-  MurmurHash3_x86_32(element, element_size, 0, &hash);
-  hash = hash % set->capacity;
+  size_t hash = (set->element_hash)(element, element_size) % set->capacity;
 
   if ((set->element_compare)(set->buckets[hash].element, element)) {
     /* the anchor's value may not be modified */
@@ -86,11 +103,13 @@ int set_insert(Set *set, void *element, size_t element_size) {
   /* make sure element is not already present; if it is, do nothing */
   if (!(set->element_compare)(prev->next->element, element)) {
     /* insert new bucket */
-    SetBucket *new_bucket = malloc(sizeof(SetBucket));
+    SetBucket *new_bucket = blib_alloc(set->allocator, sizeof(SetBucket));
+    if (!new_bucket) return 1;
     new_bucket->element = element;
     new_bucket->element_size = element_size;
     new_bucket->next = prev->next;
     prev->next = new_bucket;
+    ++(set->length);
   }
 
   return 0;
@@ -99,9 +118,7 @@ int set_insert(Set *set, void *element, size_t element_size) {
 int set_delete(Set *set, void *element, size_t element_size) {
   if (!set || !(set->buckets) || !element) return 1;
 
-  size_t hash = 0;
-  MurmurHash3_x86_32(element, element_size, 0, &hash);
-  hash = hash % set->capacity;
+  size_t hash = (set->element_hash)(element, element_size) % set->capacity;
 
   SetBucket *prev = set->buckets + hash;
   while (prev->next != (set->buckets + hash) &&
@@ -115,9 +132,11 @@ int set_delete(Set *set, void *element, size_t element_size) {
     SetBucket *to_free = prev->next;
     prev->next = to_free->next;
 
-    if (set->element_destroy) (set->element_destroy)(to_free->element);
+    if (set->element_destroy)
+      DESTROY_DATA(set->element_destroy, to_free->element);
 
-    free(to_free);
+    blib_free(set->allocator, to_free, sizeof(SetBucket));
+    --(set->length);
   }
   return 0;
 }
@@ -125,9 +144,7 @@ int set_delete(Set *set, void *element, size_t element_size) {
 int set_find(Set *set, void *element, size_t element_size, size_t *out) {
   if (!set || !(set->buckets) || !element || !out) return 0;
 
-  size_t hash = 0;
-  MurmurHash3_x86_32(element, element_size, 0, &hash);
-  hash = hash % set->capacity;
+  size_t hash = (set->element_hash)(element, element_size) % set->capacity;
   SetBucket *current = set->buckets[hash].next;
 
   size_t i = 0;
@@ -154,4 +171,45 @@ void set_foreach(Set *set, void (*fn)(void *)) {
   }
 }
 
-int set_empty(Set *set) { return set->length; }
+int set_rehash(Set *set, size_t capacity) {
+  if (!set || !(set->buckets) || capacity < 1) return 1;
+
+  SetBucket *buckets = blib_alloc(set->allocator, capacity * sizeof(SetBucket));
+  if (!buckets) return 1;
+  size_t i;
+  for (i = 0; i < capacity; ++i) {
+    buckets[i].element = NULL;
+    buckets[i].next = (buckets + i);
+  }
+
+  /* the chains are relinked into the new anchors, so no bucket moves */
+  for (i = 0; i < set->capacity; ++i) {
+    SetBucket *current = set->buckets[i].next;
+    while (current != set->buckets + i) {
+      SetBucket *next = current->next;
+      size_t hash =
+          (set->element_hash)(current->element, current->element_size) %
+          capacity;
+      current->next = buckets[hash].next;
+      buckets[hash].next = current;
+      current = next;
+    }
+  }
+
+  blib_free(set->allocator, set->buckets, set->capacity * sizeof(SetBucket));
+  set->buckets = buckets;
+  set->capacity = capacity;
+  return 0;
+}
+
+int set_set_hasher(Set *set, BlibHasher element_hash) {
+  if (!set) return 1;
+  /* the elements already stored were placed by the old hash */
+  if (set->length) return 1;
+
+  set->element_hash = element_hash ? element_hash : default_hash;
+  return 0;
+}
+
+size_t set_size(Set *set) { return set->length; }
+int set_empty(Set *set) { return set->length == 0; }
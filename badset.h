@@ -1,5 +1,5 @@
-#ifndef __BADMAP_H__
-#define __BADMAP_H__
+#ifndef __BADSET_H__
+#define __BADSET_H__
 #include <stddef.h>
 
 #include "badlib.h"
@@ -17,18 +17,30 @@ typedef struct set {
   void *default_element;
   BlibDestroyer element_destroy;
   BlibComparator element_compare;
+  BlibHasher element_hash;
+  const BlibAllocator *allocator;
   BlibError last_status;
 } Set;
 
 int set_init(Set *set, size_t capacity, BlibDestroyer element_dest,
              BlibComparator element_comp);
+int set_init_alloc(Set *set, size_t capacity, BlibDestroyer element_dest,
+                   BlibComparator element_comp,
+                   const BlibAllocator *allocator);
 int set_destroy(Set *set);
 
 void *set_get(Set *set, void *element, size_t element_size);
 int set_insert(Set *set, void *element, size_t element_size);
 int set_delete(Set *set, void *element, size_t element_size);
 int set_find(Set *set, void *element, size_t element_size, size_t *out);
+int set_rehash(Set *set, size_t capacity);
+
+/* Replaces MurmurHash3 as the hash of the elements, or restores it when
+ * element_hash is NULL. Only allowed while the set is empty.
+ */
+int set_set_hasher(Set *set, BlibHasher element_hash);
 
 void set_foreach(Set *set, void (*fn)(void *));
+size_t set_size(Set *set);
 int set_empty(Set *set);
 #endif
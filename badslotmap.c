@@ -0,0 +1,221 @@
+#include "badslotmap.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalist.h"
+#include "badlib.h"
+#include "badvec.h"
+
+#define NO_SLOT ((uint32_t)-1)
+#define LIVE(SLOT) ((SLOT)->generation & 1)
+#define HANDLE(GENERATION, INDEX) ((SlotHandle)(GENERATION) << 32 | (INDEX))
+#define SLOT_AT(MAP, INDEX) (&VEC_AT(&(MAP)->slots, Slot, (INDEX)))
+#define OWNER_AT(MAP, INDEX) (VEC_AT(&(MAP)->owners, uint32_t, (INDEX)))
+
+typedef struct slot {
+  uint32_t generation;
+  /* dense index of the value if live, otherwise the next free slot */
+  uint32_t index;
+} Slot;
+
+static BlibError last_status = BLIB_SUCCESS;
+
+/* internal functions */
+static int smap_valid(const SlotMap *map) {
+  if (map == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  } else if (map->slots.data == NULL || map->owners.data == NULL ||
+             map->values.data == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return 0;
+  } else {
+    return 1;
+  }
+}
+
+static Slot *smap_lookup(const SlotMap *map, SlotHandle handle) {
+  uint32_t index = (uint32_t)handle;
+  if (index < vec_size(&map->slots)) {
+    Slot *slot = SLOT_AT(map, index);
+    if (LIVE(slot) && slot->generation == (uint32_t)(handle >> 32))
+      return slot;
+  }
+  last_status = W_BLIB_NOT_FOUND;
+  return NULL;
+}
+
+/* Bumps the generation of a slot whose value is gone and puts it on the free
+ * list. A slot whose generation would wrap around is retired instead, so that
+ * no handle can ever resolve twice.
+ */
+static void smap_vacate(SlotMap *map, uint32_t index) {
+  Slot *slot = SLOT_AT(map, index);
+  if (++slot->generation != 0) {
+    slot->index = map->free_head;
+    map->free_head = index;
+  }
+}
+
+/* external functions */
+int smap_init(SlotMap *map, BlibDestroyer dest) {
+  return smap_init_alloc(map, dest, NULL);
+}
+
+int smap_init_alloc(SlotMap *map, BlibDestroyer dest,
+                    const BlibAllocator *allocator) {
+  if (map == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+
+  memset(map, 0, sizeof(SlotMap));
+  if (vec_init_alloc(&map->slots, sizeof(Slot), 0, allocator) ||
+      vec_init_alloc(&map->owners, sizeof(uint32_t), 0, allocator) ||
+      alist_init_alloc(&map->values, 0, allocator)) {
+    vec_destroy(&map->slots, NULL);
+    vec_destroy(&map->owners, NULL);
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  map->free_head = NO_SLOT;
+  map->data_destroy = dest;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int smap_destroy(SlotMap *map) {
+  if (map == NULL) return 0;
+  if (smap_clear(map)) return -1;
+  vec_destroy(&map->slots, NULL);
+  vec_destroy(&map->owners, NULL);
+  alist_destroy(&map->values, NULL);
+  /* paranoid free */
+  memset(map, 0, sizeof(SlotMap));
+  return 0;
+}
+
+/* every outstanding handle becomes stale */
+int smap_clear(SlotMap *map) {
+  if (!smap_valid(map)) return -1;
+
+  size_t i;
+  for (i = 0; i < vec_size(&map->owners); ++i)
+    smap_vacate(map, OWNER_AT(map, i));
+  alist_resize(&map->values, 0, map->data_destroy);
+  vec_resize(&map->owners, 0, NULL);
+  return 0;
+}
+
+/* returns BLIB_SMAP_NULL on failure */
+SlotHandle smap_insert(SlotMap *map, void *value) {
+  if (!smap_valid(map)) return BLIB_SMAP_NULL;
+
+  uint32_t index = map->free_head;
+  size_t dense = alist_size(&map->values);
+  if (index == NO_SLOT && vec_size(&map->slots) >= NO_SLOT) {
+    last_status = BLIB_INVALID_SIZE;
+    return BLIB_SMAP_NULL;
+  } else if (alist_push(&map->values, value)) {
+    return BLIB_SMAP_NULL;
+  } else if (vec_push(&map->owners, NULL)) {
+    alist_pop(&map->values, NULL);
+    return BLIB_SMAP_NULL;
+  } else if (index == NO_SLOT) {
+    /* a zeroed slot is vacant at generation 0 */
+    if (vec_push(&map->slots, NULL)) {
+      alist_pop(&map->values, NULL);
+      vec_pop(&map->owners, NULL);
+      return BLIB_SMAP_NULL;
+    }
+    index = vec_size(&map->slots) - 1;
+  } else {
+    map->free_head = SLOT_AT(map, index)->index;
+  }
+
+  Slot *slot = SLOT_AT(map, index);
+  ++slot->generation;
+  slot->index = dense;
+  OWNER_AT(map, dense) = index;
+  last_status = BLIB_SUCCESS;
+  return HANDLE(slot->generation, index);
+}
+
+void *smap_get(const SlotMap *map, SlotHandle handle) {
+  if (!smap_valid(map)) return NULL;
+  Slot *slot = smap_lookup(map, handle);
+  if (slot == NULL) return NULL;
+  last_status = BLIB_SUCCESS;
+  return map->values.data[slot->index];
+}
+
+/* replaces the value behind a live handle, destroying the old one */
+int smap_set(SlotMap *map, SlotHandle handle, void *value) {
+  if (!smap_valid(map)) return -1;
+  Slot *slot = smap_lookup(map, handle);
+  if (slot == NULL) return -1;
+  return alist_insert(&map->values, value, slot->index, map->data_destroy);
+}
+
+int smap_remove(SlotMap *map, SlotHandle handle) {
+  if (!smap_valid(map)) return -1;
+  Slot *slot = smap_lookup(map, handle);
+  if (slot == NULL) return -1;
+
+  size_t dense = slot->index, last = alist_size(&map->values) - 1;
+  void *value = map->values.data[dense];
+  if (dense != last) {
+    /* fill the hole with the last value so the array stays dense */
+    uint32_t owner = OWNER_AT(map, last);
+    alist_insert(&map->values, map->values.data[last], dense, NULL);
+    OWNER_AT(map, dense) = owner;
+    SLOT_AT(map, owner)->index = dense;
+  }
+  alist_pop(&map->values, NULL);
+  vec_pop(&map->owners, NULL);
+  smap_vacate(map, (uint32_t)handle);
+  if (value && map->data_destroy) DESTROY_DATA(map->data_destroy, value);
+  return 0;
+}
+
+int smap_contains(const SlotMap *map, SlotHandle handle) {
+  return smap_valid(map) && smap_lookup(map, handle) != NULL;
+}
+
+void *smap_value_at(const SlotMap *map, size_t index) {
+  if (!smap_valid(map)) {
+    return NULL;
+  } else if (index >= alist_size(&map->values)) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return NULL;
+  }
+  last_status = BLIB_SUCCESS;
+  return map->values.data[index];
+}
+
+SlotHandle smap_handle_at(const SlotMap *map, size_t index) {
+  if (!smap_valid(map)) {
+    return BLIB_SMAP_NULL;
+  } else if (index >= vec_size(&map->owners)) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return BLIB_SMAP_NULL;
+  }
+  uint32_t owner = OWNER_AT(map, index);
+  return HANDLE(SLOT_AT(map, owner)->generation, owner);
+}
+
+/* like alist_foreach, NULL values are skipped */
+void smap_foreach(SlotMap *map, void (*fn)(void *)) {
+  if (!smap_valid(map)) return;
+  alist_foreach(&map->values, fn);
+}
+
+size_t smap_size(const SlotMap *map) { return alist_size(&map->values); }
+int smap_empty(const SlotMap *map) { return alist_empty(&map->values); }
+int smap_status(const SlotMap *map) {
+  (void)smap_valid(map);
+  return last_status;
+}
@@ -0,0 +1,54 @@
+#ifndef __BADSLOTMAP_H__
+#define __BADSLOTMAP_H__
+#include <stddef.h>
+#include <stdint.h>
+
+#include "badalist.h"
+#include "badlib.h"
+#include "badvec.h"
+
+/* A handle packs a slot index into the low 32 bits and the generation of
+ * that slot into the high 32 bits. Generations of live slots are always odd,
+ * so BLIB_SMAP_NULL never refers to anything.
+ */
+typedef uint64_t SlotHandle;
+#define BLIB_SMAP_NULL ((SlotHandle)0)
+
+/* Values live in a dense ArrayList, so iterating over them touches no holes,
+ * and are addressed through a table of slots, each recording where its value
+ * is in the dense array. Removing a value moves the last one into its place
+ * and puts its slot on a free list; the slot's generation is bumped so that
+ * handles to the old value stop resolving instead of aliasing the next value
+ * stored there.
+ *
+ * Like an ArrayList, a SlotMap must not be copied or moved while in use.
+ */
+typedef struct smap {
+  Vector slots;
+  Vector owners;
+  ArrayList values;
+  uint32_t free_head;
+  BlibDestroyer data_destroy;
+} SlotMap;
+
+int smap_init(SlotMap *map, BlibDestroyer dest);
+int smap_init_alloc(SlotMap *map, BlibDestroyer dest,
+                    const BlibAllocator *allocator);
+int smap_destroy(SlotMap *map);
+int smap_clear(SlotMap *map);
+
+SlotHandle smap_insert(SlotMap *map, void *value);
+void *smap_get(const SlotMap *map, SlotHandle handle);
+int smap_set(SlotMap *map, SlotHandle handle, void *value);
+int smap_remove(SlotMap *map, SlotHandle handle);
+int smap_contains(const SlotMap *map, SlotHandle handle);
+
+/* dense iteration; indices are invalidated by smap_remove */
+void *smap_value_at(const SlotMap *map, size_t index);
+SlotHandle smap_handle_at(const SlotMap *map, size_t index);
+void smap_foreach(SlotMap *map, void (*fn)(void *));
+
+size_t smap_size(const SlotMap *map);
+int smap_empty(const SlotMap *map);
+int smap_status(const SlotMap *map);
+#endif
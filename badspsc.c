@@ -0,0 +1,199 @@
+#ifdef __linux__
+#define _DEFAULT_SOURCE
+#endif
+#include "badspsc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifndef __GNUC__
+#error "badspsc.c requires the GCC __atomic builtins"
+#endif
+
+#define LOAD(PTR, ORDER) __atomic_load_n((PTR), __ATOMIC_##ORDER)
+#define STORE(PTR, VAL, ORDER) __atomic_store_n((PTR), (VAL), __ATOMIC_##ORDER)
+
+/* internal functions */
+
+/* sleeps while *word is still expected; may return spuriously */
+static void event_wait(unsigned int *word, unsigned int expected) {
+#ifdef __linux__
+  syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+#else
+  (void)word;
+  (void)expected;
+#endif
+}
+
+static void event_signal(unsigned int *word) {
+  __atomic_add_fetch(word, 1, __ATOMIC_SEQ_CST);
+#ifdef __linux__
+  syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+}
+
+/* On a blocking ring, publishing a position and checking the other side's
+ * waiting flag, like setting the flag and rechecking the position before
+ * sleeping, are both sequentially consistent, so at least one side sees the
+ * other and a wakeup is never lost. The recheck must load the position itself
+ * with seq_cst rather than go through room or ready, whose acquire loads could
+ * be satisfied before the flag is seen. Nobody sleeps on other rings, so they
+ * publish with a plain release store.
+ */
+static void publish_tail(SpscRing *ring, size_t tail) {
+  if (!ring->blocking) {
+    STORE(&ring->tail, tail, RELEASE);
+  } else {
+    STORE(&ring->tail, tail, SEQ_CST);
+    if (LOAD(&ring->consumer_waiting, SEQ_CST))
+      event_signal(&ring->push_event);
+  }
+}
+
+static void publish_head(SpscRing *ring, size_t head) {
+  if (!ring->blocking) {
+    STORE(&ring->head, head, RELEASE);
+  } else {
+    STORE(&ring->head, head, SEQ_CST);
+    if (LOAD(&ring->producer_waiting, SEQ_CST))
+      event_signal(&ring->pop_event);
+  }
+}
+
+/* free slots as far as the producer can tell, refreshing its cached head
+ * only when the ring looks too full for count more
+ */
+static size_t room(SpscRing *ring, size_t count) {
+  size_t cap = ring->mask + 1;
+  if (cap - (ring->tail - ring->head_cache) < count)
+    ring->head_cache = LOAD(&ring->head, ACQUIRE);
+  return cap - (ring->tail - ring->head_cache);
+}
+
+/* published elements as far as the consumer can tell */
+static size_t ready(SpscRing *ring, size_t count) {
+  if (ring->tail_cache - ring->head < count)
+    ring->tail_cache = LOAD(&ring->tail, ACQUIRE);
+  return ring->tail_cache - ring->head;
+}
+
+/* external functions */
+int spsc_init(SpscRing *ring, size_t cap) {
+  return spsc_init_alloc(ring, cap, NULL);
+}
+
+int spsc_init_alloc(SpscRing *ring, size_t cap,
+                    const BlibAllocator *allocator) {
+  if (ring == NULL || cap == 0 || cap > ((size_t)-1 >> 1)) return -1;
+
+  size_t real_cap = 2;
+  while (real_cap < cap) real_cap <<= 1;
+  memset(ring, 0, sizeof(SpscRing));
+  ring->allocator = allocator;
+  ring->slots = blib_alloc(allocator, sizeof(void *) * real_cap);
+  if (ring->slots == NULL) return -1;
+  ring->mask = real_cap - 1;
+  return 0;
+}
+
+/* only while the ring is empty and not yet shared between threads */
+int spsc_set_blocking(SpscRing *ring, int blocking) {
+  if (ring == NULL || ring->slots == NULL || ring->head != ring->tail)
+    return -1;
+  ring->blocking = blocking != 0;
+  return 0;
+}
+
+int spsc_destroy(SpscRing *ring, BlibDestroyer destroy) {
+  if (ring == NULL) return 0;
+  if (ring->slots == NULL) return -1;
+
+  if (destroy) {
+    size_t i;
+    for (i = ring->head; i != ring->tail; ++i)
+      DESTROY_DATA(destroy, ring->slots[i & ring->mask]);
+  }
+  blib_free(ring->allocator, ring->slots, sizeof(void *) * (ring->mask + 1));
+  /* paranoid free */
+  memset(ring, 0, sizeof(SpscRing));
+  return 0;
+}
+
+int spsc_try_push(SpscRing *ring, void *element) {
+  if (element == NULL || room(ring, 1) == 0) return -1;
+  ring->slots[ring->tail & ring->mask] = element;
+  publish_tail(ring, ring->tail + 1);
+  return 0;
+}
+
+/* pushes as many of elements as fit, returning how many */
+size_t spsc_push_batch(SpscRing *ring, void *const *elements, size_t count) {
+  size_t i, free_slots = room(ring, count);
+  if (count > free_slots) count = free_slots;
+  for (i = 0; i < count; ++i) {
+    if (elements[i] == NULL) break;
+    ring->slots[(ring->tail + i) & ring->mask] = elements[i];
+  }
+  if (i) publish_tail(ring, ring->tail + i);
+  return i;
+}
+
+int spsc_push(SpscRing *ring, void *element) {
+  if (element == NULL) return -1;
+  while (spsc_try_push(ring, element)) {
+    if (!ring->blocking) continue;
+    unsigned int seen = LOAD(&ring->pop_event, SEQ_CST);
+    STORE(&ring->producer_waiting, 1, SEQ_CST);
+    ring->head_cache = LOAD(&ring->head, SEQ_CST);
+    if (ring->tail - ring->head_cache > ring->mask)
+      event_wait(&ring->pop_event, seen);
+    STORE(&ring->producer_waiting, 0, RELAXED);
+  }
+  return 0;
+}
+
+void *spsc_try_pop(SpscRing *ring) {
+  if (ready(ring, 1) == 0) return NULL;
+  void *element = ring->slots[ring->head & ring->mask];
+  publish_head(ring, ring->head + 1);
+  return element;
+}
+
+/* pops up to count elements into out, returning how many */
+size_t spsc_pop_batch(SpscRing *ring, void **out, size_t count) {
+  size_t i, available = ready(ring, count);
+  if (count > available) count = available;
+  for (i = 0; i < count; ++i)
+    out[i] = ring->slots[(ring->head + i) & ring->mask];
+  if (count) publish_head(ring, ring->head + count);
+  return count;
+}
+
+void *spsc_pop(SpscRing *ring) {
+  void *element;
+  while ((element = spsc_try_pop(ring)) == NULL) {
+    if (!ring->blocking) continue;
+    unsigned int seen = LOAD(&ring->push_event, SEQ_CST);
+    STORE(&ring->consumer_waiting, 1, SEQ_CST);
+    ring->tail_cache = LOAD(&ring->tail, SEQ_CST);
+    if (ring->tail_cache == ring->head) event_wait(&ring->push_event, seen);
+    STORE(&ring->consumer_waiting, 0, RELAXED);
+  }
+  return element;
+}
+
+/* only a snapshot while the other side is running */
+size_t spsc_size(const SpscRing *ring) {
+  return LOAD(&ring->tail, ACQUIRE) - LOAD(&ring->head, ACQUIRE);
+}
+
+size_t spsc_cap(const SpscRing *ring) { return ring->mask + 1; }
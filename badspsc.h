@@ -0,0 +1,60 @@
+#ifndef __BADSPSC_H__
+#define __BADSPSC_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+/* A ring buffer for handing pointers from exactly one producer thread to
+ * exactly one consumer thread. Neither side ever waits on the other in the
+ * try and batch functions: each only writes its own position, and keeps a
+ * cached copy of the other side's so that the shared line is only read when
+ * the ring looks full or empty. Batches publish once for all their elements.
+ *
+ * spsc_push and spsc_pop wait instead until the other side makes room or
+ * publishes. They spin, unless spsc_set_blocking has made the ring blocking,
+ * in which case they sleep on a futex on Linux (and still spin elsewhere).
+ * That costs every publish on the ring, including the try and batch ones, a
+ * full fence to check whether the other side is asleep, so only rings that
+ * need to sleep should block. As with the MPMC queues, only non-NULL pointers
+ * may be stored, failures are only reported through return values, and init,
+ * spsc_set_blocking and destroy are not thread safe.
+ */
+typedef struct spsc {
+  void **slots;
+  size_t mask;
+  const BlibAllocator *allocator;
+  int blocking;
+  char pad0[BLIB_CACHE_LINE];
+  /* written by the consumer */
+  size_t head;
+  size_t tail_cache;
+  unsigned int pop_event;
+  int consumer_waiting;
+  char pad1[BLIB_CACHE_LINE];
+  /* written by the producer */
+  size_t tail;
+  size_t head_cache;
+  unsigned int push_event;
+  int producer_waiting;
+  char pad2[BLIB_CACHE_LINE];
+} SpscRing;
+
+int spsc_init(SpscRing *ring, size_t cap);
+int spsc_init_alloc(SpscRing *ring, size_t cap,
+                    const BlibAllocator *allocator);
+int spsc_set_blocking(SpscRing *ring, int blocking);
+int spsc_destroy(SpscRing *ring, BlibDestroyer destroyer);
+
+/* producer side */
+int spsc_try_push(SpscRing *ring, void *element);
+size_t spsc_push_batch(SpscRing *ring, void *const *elements, size_t count);
+int spsc_push(SpscRing *ring, void *element);
+
+/* consumer side */
+void *spsc_try_pop(SpscRing *ring);
+size_t spsc_pop_batch(SpscRing *ring, void **out, size_t count);
+void *spsc_pop(SpscRing *ring);
+
+size_t spsc_size(const SpscRing *ring);
+size_t spsc_cap(const SpscRing *ring);
+#endif
@@ -0,0 +1,626 @@
+#ifndef __BADTMPL_H__
+#define __BADTMPL_H__
+#include <stddef.h>
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+
+/* Macro templates for type-specialized versions of the structures.
+ *
+ * Each structure has a DECLARE macro, which expands to the struct definition
+ * and function prototypes and belongs in a header, and a DEFINE macro, which
+ * expands to the function definitions and belongs in exactly one source file.
+ * Both take the typedef'd name of the structure, and a bare name that is used
+ * for the struct tag and as the prefix of every function, followed by the
+ * element (or key and value) types.
+ *
+ * DEFINE additionally takes the names of function-like macros or functions
+ * used to compare, hash and destroy elements. They are expanded in place, so
+ * the compiler can inline them instead of calling through a BlibComparator or
+ * BlibDestroyer. They are invoked as:
+ * - LESS(a, b): nonzero if a orders before b
+ * - EQUAL(a, b): nonzero if a and b are equal
+ * - HASH(a): a size_t hash of a
+ * - DESTROY(a): release whatever a owns
+ * where a and b are elements, not pointers to them.
+ *
+ * Like the untemplated structures, each has an init_alloc variant of its init
+ * that takes a BlibAllocator, and NULL means malloc.
+ *
+ * The invocations expand to complete declarations and definitions, so they
+ * should not be followed by a semicolon.
+ */
+
+#define BLIB_LESS(A, B) ((A) < (B))
+#define BLIB_EQUAL(A, B) ((A) == (B))
+#define BLIB_HASH_INT(A) ((size_t)(A))
+#define BLIB_NO_DESTROY(A) ((void)0)
+
+/* ArrayList */
+#define BLIB_ALIST_DECLARE(TYPE, NAME, T)                  \
+  typedef struct NAME {                                    \
+    T *data;                                               \
+    size_t size;                                           \
+    size_t cap;                                            \
+    const BlibAllocator *allocator;                        \
+  } TYPE;                                                  \
+                                                           \
+  int NAME##_init(TYPE *list, size_t size);                \
+  int NAME##_init_alloc(TYPE *list, size_t size,           \
+                        const BlibAllocator *allocator);   \
+  int NAME##_destroy(TYPE *list);                          \
+  T *NAME##_at(const TYPE *list, size_t index);            \
+  int NAME##_set(TYPE *list, size_t index, T element);     \
+  int NAME##_push(TYPE *list, T element);                  \
+  int NAME##_pop(TYPE *list, T *out);                      \
+  size_t NAME##_find(const TYPE *list, T target);          \
+  void NAME##_foreach(TYPE *list, void (*fn)(T *));        \
+  void NAME##_sort(TYPE *list);                            \
+  int NAME##_resize(TYPE *list, size_t size);              \
+  size_t NAME##_size(const TYPE *list);
+
+#define BLIB_ALIST_DEFINE(TYPE, NAME, T, LESS, EQUAL, DESTROY)                \
+  static int NAME##_realloc(TYPE *list, size_t cap) {                        \
+    T *new_data = blib_realloc(list->allocator, list->data,                  \
+                               sizeof(T) * list->cap, sizeof(T) * cap);      \
+    if (new_data == NULL) return -1;                                         \
+    list->data = new_data;                                                   \
+    list->cap = cap;                                                         \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  /* quicksort on the larger partitions, insertion sort on the smaller */    \
+  static void NAME##_sort_range(T *a, size_t n) {                            \
+    while (n > 16) {                                                         \
+      size_t lo = 0, hi = n - 1, mid = n / 2;                                \
+      T pivot, temp;                                                         \
+      if (LESS(a[mid], a[0])) temp = a[mid], a[mid] = a[0], a[0] = temp;     \
+      if (LESS(a[hi], a[0])) temp = a[hi], a[hi] = a[0], a[0] = temp;        \
+      if (LESS(a[hi], a[mid])) temp = a[hi], a[hi] = a[mid], a[mid] = temp;  \
+      pivot = a[mid];                                                        \
+      for (;;) {                                                             \
+        while (LESS(a[lo], pivot)) ++lo;                                     \
+        while (LESS(pivot, a[hi])) --hi;                                     \
+        if (lo >= hi) break;                                                 \
+        temp = a[lo], a[lo] = a[hi], a[hi] = temp;                           \
+        ++lo, --hi;                                                          \
+      }                                                                      \
+      /* recurse into the smaller half to bound the stack depth */           \
+      if (hi + 1 < n - hi - 1) {                                             \
+        NAME##_sort_range(a, hi + 1);                                        \
+        a += hi + 1, n -= hi + 1;                                            \
+      } else {                                                               \
+        NAME##_sort_range(a + hi + 1, n - hi - 1);                           \
+        n = hi + 1;                                                          \
+      }                                                                      \
+    }                                                                        \
+    size_t i;                                                                \
+    for (i = 1; i < n; ++i) {                                                \
+      T temp = a[i];                                                         \
+      size_t j = i;                                                          \
+      for (; j > 0 && LESS(temp, a[j - 1]); --j) a[j] = a[j - 1];            \
+      a[j] = temp;                                                           \
+    }                                                                        \
+  }                                                                          \
+                                                                             \
+  int NAME##_init(TYPE *list, size_t size) {                                 \
+    return NAME##_init_alloc(list, size, NULL);                              \
+  }                                                                          \
+                                                                             \
+  int NAME##_init_alloc(TYPE *list, size_t size,                             \
+                        const BlibAllocator *allocator) {                    \
+    if (list == NULL) return -1;                                             \
+    list->size = size;                                                       \
+    list->cap = 1;                                                           \
+    while (list->cap < list->size) list->cap <<= 1;                          \
+    list->allocator = allocator;                                             \
+    list->data = blib_alloc(allocator, sizeof(T) * list->cap);               \
+    if (list->data == NULL) return -1;                                       \
+    memset(list->data, 0, sizeof(T) * list->size);                           \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_destroy(TYPE *list) {                                           \
+    if (list == NULL || list->data == NULL) return -1;                       \
+    size_t i;                                                                \
+    for (i = 0; i < list->size; ++i) DESTROY(list->data[i]);                 \
+    blib_free(list->allocator, list->data, sizeof(T) * list->cap);           \
+    memset(list, 0, sizeof(TYPE));                                           \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  T *NAME##_at(const TYPE *list, size_t index) {                             \
+    return index < list->size ? list->data + index : NULL;                   \
+  }                                                                          \
+                                                                             \
+  int NAME##_set(TYPE *list, size_t index, T element) {                      \
+    if (index > list->size) {                                                \
+      return -1;                                                             \
+    } else if (index == list->size) {                                        \
+      return NAME##_push(list, element);                                     \
+    }                                                                        \
+    DESTROY(list->data[index]);                                              \
+    list->data[index] = element;                                             \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_push(TYPE *list, T element) {                                   \
+    if (list->size == list->cap && NAME##_realloc(list, list->cap << 1))     \
+      return -1;                                                             \
+    list->data[list->size++] = element;                                      \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_pop(TYPE *list, T *out) {                                       \
+    if (list->size == 0) return -1;                                          \
+    --list->size;                                                            \
+    if (out)                                                                 \
+      *out = list->data[list->size];                                         \
+    else                                                                     \
+      DESTROY(list->data[list->size]);                                       \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  size_t NAME##_find(const TYPE *list, T target) {                           \
+    size_t i;                                                                \
+    for (i = 0; i < list->size; ++i)                                         \
+      if (EQUAL(target, list->data[i])) return i;                            \
+    return list->size;                                                       \
+  }                                                                          \
+                                                                             \
+  void NAME##_foreach(TYPE *list, void (*fn)(T *)) {                         \
+    size_t i;                                                                \
+    for (i = 0; i < list->size; ++i) fn(list->data + i);                     \
+  }                                                                          \
+                                                                             \
+  void NAME##_sort(TYPE *list) { NAME##_sort_range(list->data, list->size); } \
+                                                                             \
+  int NAME##_resize(TYPE *list, size_t size) {                               \
+    size_t i, cap = list->cap;                                               \
+    for (i = size; i < list->size; ++i) DESTROY(list->data[i]);              \
+    while (size > cap) cap <<= 1;                                            \
+    while (cap >> 1 > size) cap >>= 1;                                       \
+    if (cap != list->cap && NAME##_realloc(list, cap)) return -1;            \
+    if (size > list->size)                                                   \
+      memset(list->data + list->size, 0, sizeof(T) * (size - list->size));   \
+    list->size = size;                                                       \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  size_t NAME##_size(const TYPE *list) { return list->size; }
+
+/* LinkedList */
+#define BLIB_LLIST_DECLARE(TYPE, NAME, T)                 \
+  struct NAME##_node {                                    \
+    struct NAME##_node *next;                             \
+    struct NAME##_node *prev;                             \
+    T data;                                               \
+  };                                                      \
+                                                          \
+  typedef struct NAME {                                   \
+    struct NAME##_node *anchor;                           \
+    size_t size;                                          \
+    const BlibAllocator *allocator;                       \
+  } TYPE;                                                 \
+                                                          \
+  int NAME##_init(TYPE *list);                            \
+  int NAME##_init_alloc(TYPE *list,                      \
+                        const BlibAllocator *allocator);  \
+  int NAME##_destroy(TYPE *list);                         \
+  int NAME##_clear(TYPE *list);                           \
+  int NAME##_push_front(TYPE *list, T element);           \
+  int NAME##_pop_front(TYPE *list, T *out);               \
+  T *NAME##_front(const TYPE *list);                      \
+  int NAME##_push_back(TYPE *list, T element);            \
+  int NAME##_pop_back(TYPE *list, T *out);                \
+  T *NAME##_back(const TYPE *list);                       \
+  size_t NAME##_find(const TYPE *list, T target);         \
+  void NAME##_foreach(TYPE *list, void (*fn)(T *));       \
+  size_t NAME##_size(const TYPE *list);
+
+#define BLIB_LLIST_DEFINE(TYPE, NAME, T, EQUAL, DESTROY)                 \
+  static int NAME##_link(TYPE *list, struct NAME##_node *pred, T element) { \
+    struct NAME##_node *node =                                            \
+        blib_alloc(list->allocator, sizeof(struct NAME##_node));          \
+    if (node == NULL) return -1;                                          \
+    node->data = element;                                                 \
+    node->prev = pred;                                                    \
+    node->next = pred->next;                                              \
+    pred->next->prev = node;                                              \
+    pred->next = node;                                                    \
+    ++list->size;                                                         \
+    return 0;                                                             \
+  }                                                                       \
+                                                                          \
+  static int NAME##_unlink(TYPE *list, struct NAME##_node *node, T *out) { \
+    if (node == list->anchor) return -1;                                  \
+    node->prev->next = node->next;                                        \
+    node->next->prev = node->prev;                                        \
+    if (out)                                                              \
+      *out = node->data;                                                  \
+    else                                                                  \
+      DESTROY(node->data);                                                \
+    blib_free(list->allocator, node, sizeof(struct NAME##_node));         \
+    --list->size;                                                         \
+    return 0;                                                             \
+  }                                                                       \
+                                                                          \
+  int NAME##_init(TYPE *list) { return NAME##_init_alloc(list, NULL); }   \
+                                                                          \
+  int NAME##_init_alloc(TYPE *list, const BlibAllocator *allocator) {     \
+    if (list == NULL) return -1;                                          \
+    list->allocator = allocator;                                          \
+    list->anchor = blib_alloc(allocator, sizeof(struct NAME##_node));     \
+    if (list->anchor == NULL) return -1;                                  \
+    list->anchor->next = list->anchor->prev = list->anchor;               \
+    list->size = 0;                                                       \
+    return 0;                                                             \
+  }                                                                       \
+                                                                          \
+  int NAME##_destroy(TYPE *list) {                                        \
+    if (NAME##_clear(list)) return -1;                                    \
+    blib_free(list->allocator, list->anchor, sizeof(struct NAME##_node)); \
+    list->anchor = NULL;                                                  \
+    return 0;                                                             \
+  }                                                                       \
+                                                                          \
+  int NAME##_clear(TYPE *list) {                                          \
+    if (list == NULL || list->anchor == NULL) return -1;                  \
+    while (list->anchor->next != list->anchor)                            \
+      NAME##_unlink(list, list->anchor->next, NULL);                      \
+    return 0;                                                             \
+  }                                                                       \
+                                                                          \
+  int NAME##_push_front(TYPE *list, T element) {                          \
+    return NAME##_link(list, list->anchor, element);                      \
+  }                                                                       \
+                                                                          \
+  int NAME##_pop_front(TYPE *list, T *out) {                              \
+    return NAME##_unlink(list, list->anchor->next, out);                  \
+  }                                                                       \
+                                                                          \
+  T *NAME##_front(const TYPE *list) {                                     \
+    return list->size ? &list->anchor->next->data : NULL;                 \
+  }                                                                       \
+                                                                          \
+  int NAME##_push_back(TYPE *list, T element) {                           \
+    return NAME##_link(list, list->anchor->prev, element);                \
+  }                                                                       \
+                                                                          \
+  int NAME##_pop_back(TYPE *list, T *out) {                               \
+    return NAME##_unlink(list, list->anchor->prev, out);                  \
+  }                                                                       \
+                                                                          \
+  T *NAME##_back(const TYPE *list) {                                      \
+    return list->size ? &list->anchor->prev->data : NULL;                 \
+  }                                                                       \
+                                                                          \
+  size_t NAME##_find(const TYPE *list, T target) {                        \
+    struct NAME##_node *node = list->anchor->next;                        \
+    size_t i;                                                             \
+    for (i = 0; node != list->anchor; ++i, node = node->next)             \
+      if (EQUAL(target, node->data)) return i;                            \
+    return list->size;                                                    \
+  }                                                                       \
+                                                                          \
+  void NAME##_foreach(TYPE *list, void (*fn)(T *)) {                      \
+    struct NAME##_node *node;                                             \
+    for (node = list->anchor->next; node != list->anchor; node = node->next) \
+      fn(&node->data);                                                    \
+  }                                                                       \
+                                                                          \
+  size_t NAME##_size(const TYPE *list) { return list->size; }
+
+/* Map
+ *
+ * Unlike Map, the specialized version uses open addressing with linear
+ * probing, so the keys and values live in flat arrays. The table is kept a
+ * power of two in size and grows once it is three quarters full. Inserting a
+ * key that is already present replaces and destroys the old value, but keeps
+ * the old key.
+ */
+#define BLIB_TMPL_MIX(H) \
+  ((H) ^= (H) >> 16, (H) *= 0x45d9f3bU, (H) ^= (H) >> 16, (H))
+
+#define BLIB_MAP_DECLARE(TYPE, NAME, K, V)                  \
+  typedef struct NAME {                                     \
+    K *keys;                                                \
+    V *values;                                              \
+    unsigned char *used;                                    \
+    size_t size;                                            \
+    size_t cap;                                             \
+    const BlibAllocator *allocator;                         \
+  } TYPE;                                                   \
+                                                            \
+  int NAME##_init(TYPE *map, size_t cap);                   \
+  int NAME##_init_alloc(TYPE *map, size_t cap,              \
+                        const BlibAllocator *allocator);    \
+  int NAME##_destroy(TYPE *map);                            \
+  int NAME##_clear(TYPE *map);                              \
+  V *NAME##_get(const TYPE *map, K key);                    \
+  int NAME##_insert(TYPE *map, K key, V value);             \
+  int NAME##_delete(TYPE *map, K key);                      \
+  void NAME##_foreach(TYPE *map, void (*fn)(K *, V *));     \
+  size_t NAME##_size(const TYPE *map);
+
+#define BLIB_MAP_DEFINE(TYPE, NAME, K, V, HASH, EQUAL, KDESTROY, VDESTROY)    \
+  static size_t NAME##_home(const TYPE *map, K key) {                        \
+    size_t hash = HASH(key);                                                 \
+    return BLIB_TMPL_MIX(hash) & (map->cap - 1);                             \
+  }                                                                          \
+                                                                             \
+  /* index of key, or of the empty slot where it would go */                 \
+  static size_t NAME##_probe(const TYPE *map, K key) {                       \
+    size_t i = NAME##_home(map, key);                                        \
+    while (map->used[i] && !EQUAL(key, map->keys[i]))                        \
+      i = (i + 1) & (map->cap - 1);                                          \
+    return i;                                                                \
+  }                                                                          \
+                                                                             \
+  static void NAME##_free(TYPE *map) {                                       \
+    blib_free(map->allocator, map->keys, sizeof(K) * map->cap);              \
+    blib_free(map->allocator, map->values, sizeof(V) * map->cap);            \
+    blib_free(map->allocator, map->used, map->cap);                          \
+  }                                                                          \
+                                                                             \
+  static int NAME##_alloc(TYPE *map, size_t cap) {                           \
+    map->keys = blib_alloc(map->allocator, sizeof(K) * cap);                 \
+    map->values = blib_alloc(map->allocator, sizeof(V) * cap);               \
+    map->used = blib_calloc(map->allocator, cap);                            \
+    map->cap = cap;                                                          \
+    map->size = 0;                                                           \
+    if (map->keys && map->values && map->used) return 0;                     \
+    NAME##_free(map);                                                        \
+    return -1;                                                               \
+  }                                                                          \
+                                                                             \
+  static int NAME##_grow(TYPE *map) {                                        \
+    TYPE old = *map;                                                         \
+    if (NAME##_alloc(map, old.cap << 1)) {                                   \
+      *map = old;                                                            \
+      return -1;                                                             \
+    }                                                                        \
+    size_t i;                                                                \
+    for (i = 0; i < old.cap; ++i) {                                          \
+      if (old.used[i]) {                                                     \
+        size_t j = NAME##_probe(map, old.keys[i]);                           \
+        map->keys[j] = old.keys[i];                                          \
+        map->values[j] = old.values[i];                                      \
+        map->used[j] = 1;                                                    \
+      }                                                                      \
+    }                                                                        \
+    map->size = old.size;                                                    \
+    NAME##_free(&old);                                                       \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_init(TYPE *map, size_t cap) {                                   \
+    return NAME##_init_alloc(map, cap, NULL);                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_init_alloc(TYPE *map, size_t cap,                               \
+                        const BlibAllocator *allocator) {                    \
+    size_t pow2 = 8;                                                         \
+    if (map == NULL) return -1;                                              \
+    map->allocator = allocator;                                              \
+    while (pow2 < cap) pow2 <<= 1;                                           \
+    return NAME##_alloc(map, pow2);                                          \
+  }                                                                          \
+                                                                             \
+  int NAME##_destroy(TYPE *map) {                                            \
+    if (NAME##_clear(map)) return -1;                                        \
+    NAME##_free(map);                                                        \
+    memset(map, 0, sizeof(TYPE));                                            \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_clear(TYPE *map) {                                              \
+    if (map == NULL || map->used == NULL) return -1;                         \
+    size_t i;                                                                \
+    for (i = 0; i < map->cap; ++i) {                                         \
+      if (map->used[i]) {                                                    \
+        KDESTROY(map->keys[i]);                                              \
+        VDESTROY(map->values[i]);                                            \
+        map->used[i] = 0;                                                    \
+      }                                                                      \
+    }                                                                        \
+    map->size = 0;                                                           \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  V *NAME##_get(const TYPE *map, K key) {                                    \
+    size_t i = NAME##_probe(map, key);                                       \
+    return map->used[i] ? map->values + i : NULL;                            \
+  }                                                                          \
+                                                                             \
+  int NAME##_insert(TYPE *map, K key, V value) {                             \
+    if ((map->size + 1) * 4 > map->cap * 3 && NAME##_grow(map)) return -1;   \
+    size_t i = NAME##_probe(map, key);                                       \
+    if (map->used[i]) {                                                      \
+      VDESTROY(map->values[i]);                                              \
+    } else {                                                                 \
+      map->keys[i] = key;                                                    \
+      map->used[i] = 1;                                                      \
+      ++map->size;                                                           \
+    }                                                                        \
+    map->values[i] = value;                                                  \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  /* backward shift deletion, so that no tombstones are needed */            \
+  int NAME##_delete(TYPE *map, K key) {                                      \
+    size_t mask = map->cap - 1, i = NAME##_probe(map, key), j = i;           \
+    if (!map->used[i]) return -1;                                            \
+    KDESTROY(map->keys[i]);                                                  \
+    VDESTROY(map->values[i]);                                                \
+    for (;;) {                                                               \
+      j = (j + 1) & mask;                                                    \
+      if (!map->used[j]) break;                                              \
+      size_t home = NAME##_home(map, map->keys[j]);                          \
+      /* move j into the hole unless its home lies in (i, j] */              \
+      if (i <= j ? (home <= i || home > j) : (home <= i && home > j)) {      \
+        map->keys[i] = map->keys[j];                                         \
+        map->values[i] = map->values[j];                                     \
+        i = j;                                                               \
+      }                                                                      \
+    }                                                                        \
+    map->used[i] = 0;                                                        \
+    --map->size;                                                             \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  void NAME##_foreach(TYPE *map, void (*fn)(K *, V *)) {                     \
+    size_t i;                                                                \
+    for (i = 0; i < map->cap; ++i)                                           \
+      if (map->used[i]) fn(map->keys + i, map->values + i);                  \
+  }                                                                          \
+                                                                             \
+  size_t NAME##_size(const TYPE *map) { return map->size; }
+
+/* Set
+ *
+ * Same table layout as the specialized Map, without the values.
+ */
+#define BLIB_SET_DECLARE(TYPE, NAME, T)                  \
+  typedef struct NAME {                                  \
+    T *elements;                                         \
+    unsigned char *used;                                 \
+    size_t size;                                         \
+    size_t cap;                                          \
+    const BlibAllocator *allocator;                      \
+  } TYPE;                                                \
+                                                         \
+  int NAME##_init(TYPE *set, size_t cap);                \
+  int NAME##_init_alloc(TYPE *set, size_t cap,           \
+                        const BlibAllocator *allocator); \
+  int NAME##_destroy(TYPE *set);                         \
+  int NAME##_clear(TYPE *set);                           \
+  int NAME##_contains(const TYPE *set, T element);       \
+  int NAME##_insert(TYPE *set, T element);               \
+  int NAME##_delete(TYPE *set, T element);               \
+  void NAME##_foreach(TYPE *set, void (*fn)(T *));       \
+  size_t NAME##_size(const TYPE *set);
+
+#define BLIB_SET_DEFINE(TYPE, NAME, T, HASH, EQUAL, DESTROY)                  \
+  static size_t NAME##_home(const TYPE *set, T element) {                    \
+    size_t hash = HASH(element);                                             \
+    return BLIB_TMPL_MIX(hash) & (set->cap - 1);                             \
+  }                                                                          \
+                                                                             \
+  static size_t NAME##_probe(const TYPE *set, T element) {                   \
+    size_t i = NAME##_home(set, element);                                    \
+    while (set->used[i] && !EQUAL(element, set->elements[i]))                \
+      i = (i + 1) & (set->cap - 1);                                          \
+    return i;                                                                \
+  }                                                                          \
+                                                                             \
+  static void NAME##_free(TYPE *set) {                                       \
+    blib_free(set->allocator, set->elements, sizeof(T) * set->cap);          \
+    blib_free(set->allocator, set->used, set->cap);                          \
+  }                                                                          \
+                                                                             \
+  static int NAME##_alloc(TYPE *set, size_t cap) {                           \
+    set->elements = blib_alloc(set->allocator, sizeof(T) * cap);             \
+    set->used = blib_calloc(set->allocator, cap);                            \
+    set->cap = cap;                                                          \
+    set->size = 0;                                                           \
+    if (set->elements && set->used) return 0;                                \
+    NAME##_free(set);                                                        \
+    return -1;                                                               \
+  }                                                                          \
+                                                                             \
+  static int NAME##_grow(TYPE *set) {                                        \
+    TYPE old = *set;                                                         \
+    if (NAME##_alloc(set, old.cap << 1)) {                                   \
+      *set = old;                                                            \
+      return -1;                                                             \
+    }                                                                        \
+    size_t i;                                                                \
+    for (i = 0; i < old.cap; ++i) {                                          \
+      if (old.used[i]) {                                                     \
+        size_t j = NAME##_probe(set, old.elements[i]);                       \
+        set->elements[j] = old.elements[i];                                  \
+        set->used[j] = 1;                                                    \
+      }                                                                      \
+    }                                                                        \
+    set->size = old.size;                                                    \
+    NAME##_free(&old);                                                       \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_init(TYPE *set, size_t cap) {                                   \
+    return NAME##_init_alloc(set, cap, NULL);                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_init_alloc(TYPE *set, size_t cap,                               \
+                        const BlibAllocator *allocator) {                    \
+    size_t pow2 = 8;                                                         \
+    if (set == NULL) return -1;                                              \
+    set->allocator = allocator;                                              \
+    while (pow2 < cap) pow2 <<= 1;                                           \
+    return NAME##_alloc(set, pow2);                                          \
+  }                                                                          \
+                                                                             \
+  int NAME##_destroy(TYPE *set) {                                            \
+    if (NAME##_clear(set)) return -1;                                        \
+    NAME##_free(set);                                                        \
+    memset(set, 0, sizeof(TYPE));                                            \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_clear(TYPE *set) {                                              \
+    if (set == NULL || set->used == NULL) return -1;                         \
+    size_t i;                                                                \
+    for (i = 0; i < set->cap; ++i) {                                         \
+      if (set->used[i]) {                                                    \
+        DESTROY(set->elements[i]);                                           \
+        set->used[i] = 0;                                                    \
+      }                                                                      \
+    }                                                                        \
+    set->size = 0;                                                           \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_contains(const TYPE *set, T element) {                          \
+    return set->used[NAME##_probe(set, element)];                            \
+  }                                                                          \
+                                                                             \
+  /* does nothing if the element is already present */                      \
+  int NAME##_insert(TYPE *set, T element) {                                  \
+    if ((set->size + 1) * 4 > set->cap * 3 && NAME##_grow(set)) return -1;   \
+    size_t i = NAME##_probe(set, element);                                   \
+    if (!set->used[i]) {                                                     \
+      set->elements[i] = element;                                            \
+      set->used[i] = 1;                                                      \
+      ++set->size;                                                           \
+    }                                                                        \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  int NAME##_delete(TYPE *set, T element) {                                  \
+    size_t mask = set->cap - 1, i = NAME##_probe(set, element), j = i;       \
+    if (!set->used[i]) return -1;                                            \
+    DESTROY(set->elements[i]);                                               \
+    for (;;) {                                                               \
+      j = (j + 1) & mask;                                                    \
+      if (!set->used[j]) break;                                              \
+      size_t home = NAME##_home(set, set->elements[j]);                      \
+      if (i <= j ? (home <= i || home > j) : (home <= i && home > j)) {      \
+        set->elements[i] = set->elements[j];                                 \
+        i = j;                                                               \
+      }                                                                      \
+    }                                                                        \
+    set->used[i] = 0;                                                        \
+    --set->size;                                                             \
+    return 0;                                                                \
+  }                                                                          \
+                                                                             \
+  void NAME##_foreach(TYPE *set, void (*fn)(T *)) {                          \
+    size_t i;                                                                \
+    for (i = 0; i < set->cap; ++i)                                           \
+      if (set->used[i]) fn(set->elements + i);                               \
+  }                                                                          \
+                                                                             \
+  size_t NAME##_size(const TYPE *set) { return set->size; }
+#endif
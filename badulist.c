@@ -0,0 +1,366 @@
+#include "badulist.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+
+#define NODE_CAP BLIB_ULIST_NODE_CAP
+#define NODE_HALF (BLIB_ULIST_NODE_CAP / 2)
+
+static BlibError last_status = BLIB_SUCCESS;
+
+/* internal functions */
+static int ulist_valid(const UnrolledList *list) {
+  if (list == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  }
+  return 1;
+}
+
+/* allocates an empty node and links it between prev and next, either of
+ * which may be NULL at the ends of the list
+ */
+static UNode *unode_new(UnrolledList *list, UNode *prev, UNode *next) {
+  UNode *node = blib_alloc(list->allocator, sizeof(UNode));
+  if (node == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return NULL;
+  }
+  node->count = 0;
+  node->prev = prev;
+  node->next = next;
+  if (prev)
+    prev->next = node;
+  else
+    list->head = node;
+  if (next)
+    next->prev = node;
+  else
+    list->tail = node;
+  ++list->node_count;
+  return node;
+}
+
+static void unode_free(UnrolledList *list, UNode *node) {
+  if (node->prev)
+    node->prev->next = node->next;
+  else
+    list->head = node->next;
+  if (node->next)
+    node->next->prev = node->prev;
+  else
+    list->tail = node->prev;
+  blib_free(list->allocator, node, sizeof(UNode));
+  --list->node_count;
+}
+
+/* Finds the node holding the element at *index, walking from the nearer end,
+ * and replaces *index with its offset in that node. An index equal to the
+ * size of the list resolves to the end of the tail.
+ */
+static UNode *unode_locate(const UnrolledList *list, size_t *index) {
+  UNode *node;
+  if (*index < list->size / 2) {
+    for (node = list->head; *index >= node->count; node = node->next)
+      *index -= node->count;
+  } else {
+    size_t from_back = list->size - *index;
+    for (node = list->tail; from_back > node->count; node = node->prev)
+      from_back -= node->count;
+    *index = node->count - from_back;
+  }
+  return node;
+}
+
+/* Inserts element at offset in node, which may be NULL if the list is empty.
+ * A full node spills into a neighbour with room when inserting at one of its
+ * ends, and otherwise is split in half.
+ */
+static int unode_insert(UnrolledList *list, UNode *node, size_t offset,
+                        void *element) {
+  if (node == NULL) {
+    node = unode_new(list, NULL, NULL);
+    if (node == NULL) return -1;
+  } else if (node->count == NODE_CAP) {
+    if (offset == 0 && node->prev && node->prev->count < NODE_CAP) {
+      node = node->prev;
+      offset = node->count;
+    } else if (offset == NODE_CAP && node->next &&
+               node->next->count < NODE_CAP) {
+      node = node->next;
+      offset = 0;
+    } else if (offset == 0 || offset == NODE_CAP) {
+      /* pushing onto a full end starts a new node rather than splitting */
+      node = offset ? unode_new(list, node, node->next)
+                    : unode_new(list, node->prev, node);
+      if (node == NULL) return -1;
+      offset = 0;
+    } else {
+      UNode *half = unode_new(list, node, node->next);
+      if (half == NULL) return -1;
+      size_t keep = NODE_CAP - NODE_HALF;
+      memcpy(half->data, node->data + keep, sizeof(void *) * NODE_HALF);
+      half->count = NODE_HALF;
+      node->count = keep;
+      if (offset > keep) {
+        node = half;
+        offset -= keep;
+      }
+    }
+  }
+
+  memmove(node->data + offset + 1, node->data + offset,
+          sizeof(void *) * (node->count - offset));
+  node->data[offset] = element;
+  ++node->count;
+  ++list->size;
+  return 0;
+}
+
+/* tops up a node that has fallen below half full from its neighbour, merging
+ * the two if they fit in one node
+ */
+static void unode_rebalance(UnrolledList *list, UNode *node) {
+  if (node->count >= NODE_HALF) {
+    return;
+  } else if (node->count == 0) {
+    unode_free(list, node);
+    return;
+  }
+
+  UNode *left = node, *right = node->next;
+  if (right == NULL) {
+    left = node->prev;
+    right = node;
+  }
+  if (left == NULL) {
+    return;
+  } else if (left->count + right->count <= NODE_CAP) {
+    memcpy(left->data + left->count, right->data,
+           sizeof(void *) * right->count);
+    left->count += right->count;
+    unode_free(list, right);
+  } else if (left == node) {
+    left->data[left->count++] = right->data[0];
+    memmove(right->data, right->data + 1, sizeof(void *) * --right->count);
+  } else {
+    memmove(right->data + 1, right->data, sizeof(void *) * right->count++);
+    right->data[0] = left->data[--left->count];
+  }
+}
+
+static void *unode_remove(UnrolledList *list, UNode *node, size_t offset) {
+  void *ret = node->data[offset];
+  memmove(node->data + offset, node->data + offset + 1,
+          sizeof(void *) * (node->count - offset - 1));
+  --node->count;
+  --list->size;
+  unode_rebalance(list, node);
+  return ret;
+}
+
+/* external functions */
+int ulist_init(UnrolledList *list, BlibDestroyer dest, BlibComparator comp) {
+  return ulist_init_alloc(list, dest, comp, NULL);
+}
+
+int ulist_init_alloc(UnrolledList *list, BlibDestroyer dest,
+                     BlibComparator comp, const BlibAllocator *allocator) {
+  if (list == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->size = 0;
+  list->node_count = 0;
+  list->data_destroy = dest;
+  list->data_compare = comp;
+  list->allocator = allocator;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int ulist_destroy(UnrolledList *list) {
+  if (list == NULL) return 0;
+  return ulist_clear(list);
+}
+
+int ulist_clear(UnrolledList *list) {
+  if (!ulist_valid(list)) return -1;
+
+  while (list->head) {
+    UNode *node = list->head;
+    if (list->data_destroy) {
+      size_t i;
+      for (i = 0; i < node->count; ++i)
+        DESTROY_DATA(list->data_destroy, node->data[i]);
+    }
+    unode_free(list, node);
+  }
+  list->size = 0;
+  return 0;
+}
+
+int ulist_push_front(UnrolledList *list, void *element) {
+  if (!ulist_valid(list)) return -1;
+  return unode_insert(list, list->head, 0, element);
+}
+
+void *ulist_pop_front(UnrolledList *list) {
+  if (!ulist_valid(list)) {
+    return NULL;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return unode_remove(list, list->head, 0);
+}
+
+void *ulist_front(const UnrolledList *list) {
+  if (!ulist_valid(list)) {
+    return NULL;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return list->head->data[0];
+}
+
+int ulist_push_back(UnrolledList *list, void *element) {
+  if (!ulist_valid(list)) return -1;
+  return unode_insert(list, list->tail, list->tail ? list->tail->count : 0,
+                      element);
+}
+
+void *ulist_pop_back(UnrolledList *list) {
+  if (!ulist_valid(list)) {
+    return NULL;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return unode_remove(list, list->tail, list->tail->count - 1);
+}
+
+void *ulist_back(const UnrolledList *list) {
+  if (!ulist_valid(list)) {
+    return NULL;
+  } else if (list->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  }
+  return list->tail->data[list->tail->count - 1];
+}
+
+void *ulist_get(const UnrolledList *list, size_t index) {
+  if (!ulist_valid(list)) {
+    return NULL;
+  } else if (index >= list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return NULL;
+  }
+  UNode *node = unode_locate(list, &index);
+  return node->data[index];
+}
+
+int ulist_set(UnrolledList *list, void *element, size_t index) {
+  if (!ulist_valid(list)) {
+    return -1;
+  } else if (index >= list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+  UNode *node = unode_locate(list, &index);
+  if (list->data_destroy) DESTROY_DATA(list->data_destroy, node->data[index]);
+  node->data[index] = element;
+  return 0;
+}
+
+int ulist_insert(UnrolledList *list, void *element, size_t index) {
+  if (!ulist_valid(list)) {
+    return -1;
+  } else if (index > list->size) { /* allow inserting at the very end */
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  } else if (list->size == 0) {
+    return unode_insert(list, NULL, 0, element);
+  }
+  UNode *node = unode_locate(list, &index);
+  return unode_insert(list, node, index, element);
+}
+
+int ulist_delete(UnrolledList *list, size_t index) {
+  if (!ulist_valid(list)) {
+    return -1;
+  } else if (index >= list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+  UNode *node = unode_locate(list, &index);
+  void *element = unode_remove(list, node, index);
+  if (list->data_destroy) DESTROY_DATA(list->data_destroy, element);
+  return 0;
+}
+
+void *ulist_extract(UnrolledList *list, size_t index) {
+  if (!ulist_valid(list)) {
+    return NULL;
+  } else if (index >= list->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return NULL;
+  }
+  UNode *node = unode_locate(list, &index);
+  return unode_remove(list, node, index);
+}
+
+size_t ulist_find(const UnrolledList *list, void *target) {
+  if (!ulist_valid(list) || !target) return -1;
+  size_t i, base = 0;
+  UNode *node;
+  for (node = list->head; node; base += node->count, node = node->next) {
+    for (i = 0; i < node->count; ++i) {
+      if (list->data_compare ? list->data_compare(target, node->data[i])
+                             : target == node->data[i])
+        return base + i;
+    }
+  }
+  last_status = W_BLIB_NOT_FOUND;
+  return -1;
+}
+
+size_t ulist_rfind(const UnrolledList *list, void *target) {
+  if (!ulist_valid(list) || !target) return -1;
+  size_t i, base = list->size;
+  UNode *node;
+  for (node = list->tail; node; node = node->prev) {
+    base -= node->count;
+    for (i = node->count; i > 0; --i) {
+      if (list->data_compare ? list->data_compare(target, node->data[i - 1])
+                             : target == node->data[i - 1])
+        return base + i - 1;
+    }
+  }
+  last_status = W_BLIB_NOT_FOUND;
+  return -1;
+}
+
+void ulist_foreach(UnrolledList *list, void (*fn)(void *)) {
+  if (!ulist_valid(list) || !fn) return;
+  UNode *node;
+  size_t i;
+  for (node = list->head; node; node = node->next)
+    for (i = 0; i < node->count; ++i) fn(node->data[i]);
+}
+
+size_t ulist_size(const UnrolledList *list) { return list->size; }
+int ulist_empty(const UnrolledList *list) { return list->size == 0; }
+int ulist_status(const UnrolledList *list) {
+  (void)ulist_valid(list);
+  return last_status;
+}
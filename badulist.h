@@ -0,0 +1,68 @@
+#ifndef __BADULIST_H__
+#define __BADULIST_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+/* number of elements per node; with the two links and the count, a node is
+ * 16 words, two cache lines on most 64-bit machines
+ */
+#ifndef BLIB_ULIST_NODE_CAP
+#define BLIB_ULIST_NODE_CAP 13
+#endif
+
+#define BLIB_ULIST_EMPTY \
+  { NULL, NULL, 0, 0, NULL, NULL, NULL }
+
+typedef struct unode {
+  struct unode *next;
+  struct unode *prev;
+  size_t count;
+  void *data[BLIB_ULIST_NODE_CAP];
+} UNode;
+
+/* An unrolled linked list: each node holds up to BLIB_ULIST_NODE_CAP elements
+ * in order, so the list costs about one allocation and one cache miss per
+ * node instead of per element, while inserting in the middle still only
+ * shifts the elements of one node. A full node is split in half to make
+ * room, and a node that drops below half full after a deletion borrows from
+ * or merges with a neighbour. Nodes at either end that are being filled by
+ * pushes may hold fewer.
+ */
+typedef struct ulist {
+  UNode *head;
+  UNode *tail;
+  size_t size;
+  size_t node_count;
+  BlibDestroyer data_destroy;
+  BlibComparator data_compare;
+  const BlibAllocator *allocator;
+} UnrolledList;
+
+int ulist_init(UnrolledList *list, BlibDestroyer dest, BlibComparator comp);
+int ulist_init_alloc(UnrolledList *list, BlibDestroyer dest,
+                     BlibComparator comp, const BlibAllocator *allocator);
+int ulist_destroy(UnrolledList *list);
+int ulist_clear(UnrolledList *list);
+
+int ulist_push_front(UnrolledList *list, void *element);
+void *ulist_pop_front(UnrolledList *list);
+void *ulist_front(const UnrolledList *list);
+
+int ulist_push_back(UnrolledList *list, void *element);
+void *ulist_pop_back(UnrolledList *list);
+void *ulist_back(const UnrolledList *list);
+
+void *ulist_get(const UnrolledList *list, size_t index);
+int ulist_set(UnrolledList *list, void *element, size_t index);
+int ulist_insert(UnrolledList *list, void *element, size_t index);
+int ulist_delete(UnrolledList *list, size_t index);
+void *ulist_extract(UnrolledList *list, size_t index);
+size_t ulist_find(const UnrolledList *list, void *target);
+size_t ulist_rfind(const UnrolledList *list, void *target);
+void ulist_foreach(UnrolledList *list, void (*fn)(void *));
+
+size_t ulist_size(const UnrolledList *list);
+int ulist_empty(const UnrolledList *list);
+int ulist_status(const UnrolledList *list);
+#endif
@@ -0,0 +1,290 @@
+#include "badvec.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalloc.h"
+#include "badlib.h"
+
+static BlibError last_status = BLIB_SUCCESS;
+
+/* internal functions */
+static int vec_valid(const Vector *vec) {
+  if (vec == NULL || vec->cap == 0 || vec->element_size == 0) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  } else if (vec->data == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return 0;
+  } else {
+    return 1;
+  }
+}
+
+static char *vec_slot(const Vector *vec, size_t index) {
+  return vec->data + index * vec->element_size;
+}
+
+/* doubles cap until it holds size elements, stopping at the largest capacity
+ * whose byte count fits in a size_t; size must not be larger than that
+ */
+static size_t vec_grow_cap(size_t element_size, size_t cap, size_t size) {
+  size_t limit = (size_t)-1 / element_size;
+  while (cap < size) cap = cap > limit >> 1 ? limit : cap << 1;
+  return cap;
+}
+
+static int vec_realloc(Vector *vec, size_t cap) {
+  char *new_data = blib_realloc(vec->allocator, vec->data,
+                                vec->element_size * vec->cap,
+                                vec->element_size * cap);
+  if (new_data == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  vec->data = new_data;
+  vec->cap = cap;
+  return 0;
+}
+
+static void vec_destroy_range(Vector *vec, size_t start, size_t end,
+                              BlibDestroyer destroy) {
+  size_t i;
+  if (destroy)
+    for (i = start; i < end; ++i) DESTROY_DATA(destroy, vec_slot(vec, i));
+}
+
+/* external functions */
+int vec_init(Vector *vec, size_t element_size, size_t size) {
+  return vec_init_alloc(vec, element_size, size, NULL);
+}
+
+int vec_init_alloc(Vector *vec, size_t element_size, size_t size,
+                   const BlibAllocator *allocator) {
+  if (vec == NULL || element_size == 0) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  } else if (size > (size_t)-1 / element_size) {
+    last_status = BLIB_INVALID_SIZE;
+    return -1;
+  }
+
+  vec->element_size = element_size;
+  vec->size = size;
+  vec->cap = vec_grow_cap(element_size, 1, size);
+  vec->allocator = allocator;
+  vec->data = blib_alloc(allocator, element_size * vec->cap);
+  if (vec->data == NULL) {
+    last_status = BLIB_ALLOC_FAIL;
+    return -1;
+  }
+  memset(vec->data, 0, element_size * vec->size);
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int vec_destroy(Vector *vec, BlibDestroyer destroy) {
+  if (vec == NULL)
+    return 0;
+  else if (!vec_valid(vec))
+    return -1;
+
+  vec_destroy_range(vec, 0, vec->size, destroy);
+  blib_free(vec->allocator, vec->data, vec->element_size * vec->cap);
+  /* paranoid free */
+  memset(vec, 0, sizeof(Vector));
+  return 0;
+}
+
+/* like alist_clear, the size is kept and the elements are zeroed */
+int vec_clear(Vector *vec, BlibDestroyer destroy) {
+  if (!vec_valid(vec)) return -1;
+
+  vec_destroy_range(vec, 0, vec->size, destroy);
+  memset(vec->data, 0, vec->element_size * vec->size);
+  return 0;
+}
+
+void *vec_get(const Vector *vec, size_t index) {
+  if (!vec_valid(vec)) {
+    return NULL;
+  } else if (index >= vec->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return NULL;
+  } else {
+    last_status = BLIB_SUCCESS;
+    return vec_slot(vec, index);
+  }
+}
+
+/* replaces the element at index, or appends if index is the size of the
+ * vector. A NULL element inserts a zeroed one.
+ */
+int vec_insert(Vector *vec, const void *element, size_t index,
+               BlibDestroyer destroy) {
+  if (!vec_valid(vec)) {
+    return -1;
+  } else if (index > vec->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  } else if (index == vec->size) {
+    if (index == vec->cap) {
+      if (index == (size_t)-1 / vec->element_size) {
+        last_status = BLIB_INVALID_SIZE;
+        return -1;
+      }
+      if (vec_realloc(vec, vec_grow_cap(vec->element_size, index, index + 1)))
+        return -1;
+    }
+    ++vec->size;
+  } else if (destroy) {
+    DESTROY_DATA(destroy, vec_slot(vec, index));
+  }
+
+  if (element)
+    memcpy(vec_slot(vec, index), element, vec->element_size);
+  else
+    memset(vec_slot(vec, index), 0, vec->element_size);
+  return 0;
+}
+
+/* there is no empty value to leave behind, so unlike alist_delete the
+ * elements after index are shifted down to fill the gap
+ */
+int vec_delete(Vector *vec, size_t index, BlibDestroyer destroy) {
+  if (!vec_valid(vec)) {
+    return -1;
+  } else if (index >= vec->size) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return -1;
+  }
+
+  if (destroy) DESTROY_DATA(destroy, vec_slot(vec, index));
+  memmove(vec_slot(vec, index), vec_slot(vec, index + 1),
+          vec->element_size * (vec->size - index - 1));
+  --vec->size;
+  return 0;
+}
+
+int vec_push(Vector *vec, const void *element) {
+  if (!vec_valid(vec)) return -1;
+  return vec_insert(vec, element, vec->size, NULL);
+}
+
+int vec_pop(Vector *vec, BlibDestroyer destroy) {
+  if (!vec_valid(vec)) {
+    return -1;
+  } else if (vec->size == 0) {
+    last_status = BLIB_EMPTY;
+    return -1;
+  } else {
+    --vec->size;
+    if (destroy) DESTROY_DATA(destroy, vec_slot(vec, vec->size));
+    return 0;
+  }
+}
+
+void *vec_peek(Vector *vec) {
+  if (!vec_valid(vec)) {
+    return NULL;
+  } else if (vec->size == 0) {
+    last_status = BLIB_EMPTY;
+    return NULL;
+  } else {
+    last_status = BLIB_SUCCESS;
+    return vec_slot(vec, vec->size - 1);
+  }
+}
+
+/* if compare is NULL, elements are compared bytewise */
+size_t vec_find(const Vector *vec, const void *target, BlibComparator compare) {
+  if (!vec_valid(vec)) return -1;
+
+  size_t i;
+  for (i = 0; i < vec->size; ++i) {
+    char *element = vec_slot(vec, i);
+    if (compare ? compare((void *)target, element)
+                : !memcmp(target, element, vec->element_size))
+      return i;
+  }
+
+  last_status = W_BLIB_NOT_FOUND;
+  return vec->size;
+}
+
+size_t vec_rfind(const Vector *vec, const void *target,
+                 BlibComparator compare) {
+  if (!vec_valid(vec)) return -1;
+
+  size_t i;
+  for (i = vec->size; i > 0; --i) {
+    char *element = vec_slot(vec, i - 1);
+    if (compare ? compare((void *)target, element)
+                : !memcmp(target, element, vec->element_size))
+      return i - 1;
+  }
+
+  last_status = W_BLIB_NOT_FOUND;
+  return vec->size;
+}
+
+void vec_foreach(Vector *vec, void (*fn)(void *)) {
+  if (!vec_valid(vec)) {
+    return;
+  } else if (!fn) {
+    last_status = BLIB_INVALID_STRUCT;
+    return;
+  }
+
+  char *element = vec->data, *end = vec_slot(vec, vec->size);
+  for (; element < end; element += vec->element_size) fn(element);
+}
+
+/* compare has the semantics of the comparator passed to qsort */
+void vec_sort(Vector *vec, int (*compare)(const void *, const void *)) {
+  if (!vec_valid(vec)) {
+    return;
+  } else if (!compare) {
+    last_status = BLIB_INVALID_STRUCT;
+    return;
+  }
+
+  qsort(vec->data, vec->size, vec->element_size, compare);
+}
+
+int vec_resize(Vector *vec, size_t size, BlibDestroyer destroy) {
+  if (!vec_valid(vec)) return -1;
+
+  if (size > vec->size) {
+    if (size > (size_t)-1 / vec->element_size) {
+      last_status = BLIB_INVALID_SIZE;
+      return -1;
+    }
+    if (size > vec->cap &&
+        vec_realloc(vec, vec_grow_cap(vec->element_size, vec->cap, size)))
+      return -1;
+    memset(vec_slot(vec, vec->size), 0,
+           vec->element_size * (size - vec->size));
+  } else {
+    vec_destroy_range(vec, size, vec->size, destroy);
+    /* the elements are gone either way, so a failed shrink just keeps the
+     * larger buffer
+     */
+    if (vec->cap >> 1 > size) {
+      size_t cap = vec->cap;
+      while (cap >> 1 > size) cap >>= 1;
+      vec_realloc(vec, cap);
+    }
+  }
+  vec->size = size;
+  return 0;
+}
+
+size_t vec_size(const Vector *vec) { return vec->size; }
+size_t vec_cap(const Vector *vec) { return vec->cap; }
+int vec_empty(const Vector *vec) { return vec->size == 0; }
+int vec_status(const Vector *vec) {
+  (void)vec_valid(vec);
+  return last_status;
+}
@@ -0,0 +1,53 @@
+#ifndef __BADVEC_H__
+#define __BADVEC_H__
+#include <stddef.h>
+
+#include "badlib.h"
+
+#define BLIB_VEC_EMPTY \
+  { NULL, 0, 0, 0, NULL }
+
+/* convenience wrappers for vectors of a single static type */
+#define VEC_INIT(VEC, TYPE, SIZE) vec_init((VEC), sizeof(TYPE), (SIZE))
+#define VEC_AT(VEC, TYPE, INDEX) (((TYPE *)(VEC)->data)[(INDEX)])
+
+/* Elements are stored inline, `element_size` bytes each, so there is no
+ * per-element allocation. Functions that hand out elements return pointers
+ * into `data`, which are invalidated by anything that grows or shrinks the
+ * vector. Destroyers are passed a pointer to the element being removed.
+ */
+typedef struct vec {
+  char *data;
+  size_t element_size;
+  size_t size;
+  size_t cap;
+  const BlibAllocator *allocator;
+} Vector;
+
+int vec_init(Vector *vec, size_t element_size, size_t size);
+int vec_init_alloc(Vector *vec, size_t element_size, size_t size,
+                   const BlibAllocator *allocator);
+int vec_destroy(Vector *vec, BlibDestroyer destroyer);
+int vec_clear(Vector *vec, BlibDestroyer destroyer);
+
+void *vec_get(const Vector *vec, size_t index);
+int vec_insert(Vector *vec, const void *element, size_t index,
+               BlibDestroyer destroyer);
+int vec_delete(Vector *vec, size_t index, BlibDestroyer destroyer);
+
+int vec_push(Vector *vec, const void *element);
+int vec_pop(Vector *vec, BlibDestroyer destroyer);
+void *vec_peek(Vector *vec);
+
+size_t vec_find(const Vector *vec, const void *target, BlibComparator compare);
+size_t vec_rfind(const Vector *vec, const void *target,
+                 BlibComparator compare);
+void vec_foreach(Vector *vec, void (*fn)(void *));
+void vec_sort(Vector *vec, int (*compare)(const void *, const void *));
+int vec_resize(Vector *vec, size_t size, BlibDestroyer destroyer);
+
+size_t vec_size(const Vector *vec);
+size_t vec_cap(const Vector *vec);
+int vec_empty(const Vector *vec);
+int vec_status(const Vector *vec);
+#endif
@@ -0,0 +1,484 @@
+#include "badwbt.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "badalist.h"
+#include "badalloc.h"
+#include "badlib.h"
+
+static BlibError last_status = BLIB_SUCCESS;
+
+#define SIZE(NODE) ((NODE) ? (NODE)->size : 0)
+
+/* A subtree may weigh at most DELTA times its sibling, weights being sizes
+ * plus one. Rebalancing a right-heavy node takes a double rotation when the
+ * inner grandchild weighs at least GAMMA times the outer one. With (3, 2),
+ * one rotation per level restores the balance after any single insert or
+ * delete.
+ */
+#define DELTA 3
+#define GAMMA 2
+
+/* internal functions */
+static int wbt_valid(const WBTree *tree) {
+  if (tree == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return 0;
+  } else if (tree->key_compare == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return 0;
+  }
+  return 1;
+}
+
+/* makes sure the pool holds at least count free nodes */
+static int pool_reserve(WBTree *tree, size_t count) {
+  WbtNode *node;
+  for (node = tree->free_nodes; node && count; node = node->right) --count;
+  while (count) {
+    WbtChunk *chunk = blib_alloc(tree->allocator, sizeof(WbtChunk));
+    if (chunk == NULL) {
+      last_status = BLIB_ALLOC_FAIL;
+      return -1;
+    }
+    chunk->next = tree->chunks;
+    tree->chunks = chunk;
+    size_t i;
+    for (i = BLIB_WBT_CHUNK; i-- > 0;) {
+      chunk->nodes[i].right = tree->free_nodes;
+      tree->free_nodes = chunk->nodes + i;
+    }
+    count = count > BLIB_WBT_CHUNK ? count - BLIB_WBT_CHUNK : 0;
+  }
+  return 0;
+}
+
+static WbtNode *node_alloc(WBTree *tree) {
+  if (tree->free_nodes == NULL && pool_reserve(tree, 1)) return NULL;
+  WbtNode *node = tree->free_nodes;
+  tree->free_nodes = node->right;
+  return node;
+}
+
+static void node_free(WBTree *tree, WbtNode *node) {
+  node->right = tree->free_nodes;
+  tree->free_nodes = node;
+}
+
+static WbtNode *leftmost(WbtNode *node) {
+  if (node)
+    while (node->left) node = node->left;
+  return node;
+}
+
+static WbtNode *rightmost(WbtNode *node) {
+  if (node)
+    while (node->right) node = node->right;
+  return node;
+}
+
+static void replace_child(WBTree *tree, WbtNode *parent, WbtNode *old,
+                          WbtNode *new_child) {
+  if (parent == NULL)
+    tree->root = new_child;
+  else if (parent->left == old)
+    parent->left = new_child;
+  else
+    parent->right = new_child;
+  if (new_child) new_child->parent = parent;
+}
+
+static WbtNode *rotate_left(WBTree *tree, WbtNode *node) {
+  WbtNode *right = node->right;
+  node->right = right->left;
+  if (right->left) right->left->parent = node;
+  replace_child(tree, node->parent, node, right);
+  right->left = node;
+  node->parent = right;
+  right->size = node->size;
+  node->size = SIZE(node->left) + SIZE(node->right) + 1;
+  return right;
+}
+
+static WbtNode *rotate_right(WBTree *tree, WbtNode *node) {
+  WbtNode *left = node->left;
+  node->left = left->right;
+  if (left->right) left->right->parent = node;
+  replace_child(tree, node->parent, node, left);
+  left->right = node;
+  node->parent = left;
+  left->size = node->size;
+  node->size = SIZE(node->left) + SIZE(node->right) + 1;
+  return left;
+}
+
+/* returns the root of the subtree that was rooted at node */
+static WbtNode *balance(WBTree *tree, WbtNode *node) {
+  size_t left = SIZE(node->left) + 1, right = SIZE(node->right) + 1;
+  if (right > DELTA * left) {
+    WbtNode *child = node->right;
+    if (SIZE(child->left) + 1 >= GAMMA * (SIZE(child->right) + 1))
+      rotate_right(tree, child);
+    return rotate_left(tree, node);
+  } else if (left > DELTA * right) {
+    WbtNode *child = node->left;
+    if (SIZE(child->right) + 1 >= GAMMA * (SIZE(child->left) + 1))
+      rotate_left(tree, child);
+    return rotate_right(tree, node);
+  }
+  return node;
+}
+
+/* fixes sizes and balance on the path from node to the root */
+static void rebalance_up(WBTree *tree, WbtNode *node) {
+  while (node) {
+    node->size = SIZE(node->left) + SIZE(node->right) + 1;
+    node = balance(tree, node)->parent;
+  }
+}
+
+/* links the n pooled nodes for keys and values into a perfectly balanced
+ * subtree, in order
+ */
+static WbtNode *build(WBTree *tree, void **keys, void **values, size_t n,
+                      WbtNode *parent) {
+  if (n == 0) return NULL;
+  size_t mid = n / 2;
+  WbtNode *node = node_alloc(tree);
+  node->parent = parent;
+  node->size = n;
+  node->key = keys[mid];
+  node->value = values ? values[mid] : NULL;
+  node->left = build(tree, keys, values, mid, node);
+  node->right = build(tree, keys + mid + 1, values ? values + mid + 1 : NULL,
+                      n - mid - 1, node);
+  return node;
+}
+
+/* external functions */
+int wbt_init(WBTree *tree, BlibDestroyer key_dest, BlibDestroyer value_dest,
+             BlibComparator key_comp) {
+  return wbt_init_alloc(tree, key_dest, value_dest, key_comp, NULL);
+}
+
+int wbt_init_alloc(WBTree *tree, BlibDestroyer key_dest,
+                   BlibDestroyer value_dest, BlibComparator key_comp,
+                   const BlibAllocator *allocator) {
+  if (tree == NULL) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  } else if (key_comp == NULL) {
+    last_status = BLIB_COMPARE_ERROR;
+    return -1;
+  }
+  tree->root = NULL;
+  tree->free_nodes = NULL;
+  tree->chunks = NULL;
+  tree->key_destroy = key_dest;
+  tree->value_destroy = value_dest;
+  tree->key_compare = key_comp;
+  tree->allocator = allocator;
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+/* Builds a tree from keys in strictly increasing order in O(n), with the
+ * value for keys[i] at values[i]; values may be NULL for a set. Neither list
+ * may have holes among the keys. The elements are moved rather than copied,
+ * so both lists are left empty.
+ */
+int wbt_from_alist(WBTree *tree, ArrayList *keys, ArrayList *values,
+                   BlibDestroyer key_dest, BlibDestroyer value_dest,
+                   BlibComparator key_comp) {
+  return wbt_from_alist_alloc(tree, keys, values, key_dest, value_dest,
+                              key_comp, NULL);
+}
+
+int wbt_from_alist_alloc(WBTree *tree, ArrayList *keys, ArrayList *values,
+                         BlibDestroyer key_dest, BlibDestroyer value_dest,
+                         BlibComparator key_comp,
+                         const BlibAllocator *allocator) {
+  if (wbt_init_alloc(tree, key_dest, value_dest, key_comp, allocator)) {
+    return -1;
+  } else if (keys == NULL || keys->data == NULL ||
+             (values && (values->data == NULL || values->size != keys->size))) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  } else if (keys->count != keys->size) {
+    last_status = BLIB_INVALID_STRUCT;
+    return -1;
+  }
+
+  size_t i;
+  for (i = 1; i < keys->size; ++i) {
+    if (key_comp(keys->data[i - 1], keys->data[i]) >= 0) {
+      last_status = BLIB_COMPARE_ERROR;
+      return -1;
+    }
+  }
+  if (pool_reserve(tree, keys->size)) {
+    wbt_destroy(tree);
+    return -1;
+  }
+  tree->root =
+      build(tree, keys->data, values ? values->data : NULL, keys->size, NULL);
+  alist_erase_range(keys, 0, keys->size, NULL);
+  if (values) alist_erase_range(values, 0, values->size, NULL);
+  return 0;
+}
+
+int wbt_destroy(WBTree *tree) {
+  if (tree == NULL) return 0;
+  if (wbt_clear(tree)) return -1;
+  /* paranoid free */
+  memset(tree, 0, sizeof(WBTree));
+  return 0;
+}
+
+/* destroys every key and value, and gives the pool's memory back */
+int wbt_clear(WBTree *tree) {
+  if (!wbt_valid(tree)) return -1;
+  WbtNode *node;
+  if (tree->key_destroy || tree->value_destroy) {
+    for (node = leftmost(tree->root); node; node = wbt_next(node)) {
+      if (tree->key_destroy) DESTROY_DATA(tree->key_destroy, node->key);
+      if (tree->value_destroy) DESTROY_DATA(tree->value_destroy, node->value);
+    }
+  }
+  while (tree->chunks) {
+    WbtChunk *next = tree->chunks->next;
+    blib_free(tree->allocator, tree->chunks, sizeof(WbtChunk));
+    tree->chunks = next;
+  }
+  tree->root = NULL;
+  tree->free_nodes = NULL;
+  return 0;
+}
+
+/* When key is already present its value is replaced and destroyed, and the
+ * tree keeps the key it has, destroying the new one unless it is the same
+ * pointer.
+ */
+int wbt_insert(WBTree *tree, void *key, void *value) {
+  if (!wbt_valid(tree)) return -1;
+
+  WbtNode *parent = NULL, **link = &tree->root;
+  while (*link) {
+    int order = tree->key_compare(key, (*link)->key);
+    if (order == 0) {
+      WbtNode *node = *link;
+      if (tree->value_destroy && node->value != value)
+        DESTROY_DATA(tree->value_destroy, node->value);
+      if (tree->key_destroy && node->key != key)
+        DESTROY_DATA(tree->key_destroy, key);
+      node->value = value;
+      last_status = W_BLIB_ELEMENT_REPLACED;
+      return 0;
+    }
+    parent = *link;
+    link = order < 0 ? &parent->left : &parent->right;
+  }
+
+  WbtNode *node = node_alloc(tree);
+  if (node == NULL) return -1;
+  node->left = node->right = NULL;
+  node->parent = parent;
+  node->size = 1;
+  node->key = key;
+  node->value = value;
+  *link = node;
+  rebalance_up(tree, parent);
+  last_status = BLIB_SUCCESS;
+  return 0;
+}
+
+int wbt_delete(WBTree *tree, void *key) {
+  WbtNode *node = wbt_find(tree, key);
+  if (node == NULL) return -1;
+
+  if (tree->key_destroy) DESTROY_DATA(tree->key_destroy, node->key);
+  if (tree->value_destroy) DESTROY_DATA(tree->value_destroy, node->value);
+  if (node->left && node->right) {
+    /* the successor has no left child, so it is the one unlinked */
+    WbtNode *successor = leftmost(node->right);
+    node->key = successor->key;
+    node->value = successor->value;
+    node = successor;
+  }
+  WbtNode *parent = node->parent;
+  replace_child(tree, parent, node, node->left ? node->left : node->right);
+  node_free(tree, node);
+  rebalance_up(tree, parent);
+  return 0;
+}
+
+void *wbt_get(const WBTree *tree, void *key) {
+  WbtNode *node = wbt_find(tree, key);
+  return node ? node->value : NULL;
+}
+
+WbtNode *wbt_find(const WBTree *tree, void *key) {
+  if (!wbt_valid(tree)) return NULL;
+  WbtNode *node = tree->root;
+  while (node) {
+    int order = tree->key_compare(key, node->key);
+    if (order == 0) {
+      last_status = BLIB_SUCCESS;
+      return node;
+    }
+    node = order < 0 ? node->left : node->right;
+  }
+  last_status = W_BLIB_NOT_FOUND;
+  return NULL;
+}
+
+int wbt_contains(const WBTree *tree, void *key) {
+  return wbt_find(tree, key) != NULL;
+}
+
+/* the node with the index-th smallest key, counting from 0 */
+WbtNode *wbt_select(const WBTree *tree, size_t index) {
+  if (!wbt_valid(tree)) {
+    return NULL;
+  } else if (index >= SIZE(tree->root)) {
+    last_status = BLIB_OUT_OF_BOUNDS;
+    return NULL;
+  }
+  WbtNode *node = tree->root;
+  for (;;) {
+    size_t left = SIZE(node->left);
+    if (index < left) {
+      node = node->left;
+    } else if (index == left) {
+      return node;
+    } else {
+      index -= left + 1;
+      node = node->right;
+    }
+  }
+}
+
+/* the number of keys less than key, whether or not key is present */
+size_t wbt_rank(const WBTree *tree, void *key) {
+  if (!wbt_valid(tree)) return 0;
+  WbtNode *node = tree->root;
+  size_t rank = 0;
+  while (node) {
+    if (tree->key_compare(key, node->key) <= 0) {
+      node = node->left;
+    } else {
+      rank += SIZE(node->left) + 1;
+      node = node->right;
+    }
+  }
+  return rank;
+}
+
+/* the index of node's key, found through its ancestors */
+size_t wbt_node_rank(const WbtNode *node) {
+  size_t rank = SIZE(node->left);
+  for (; node->parent; node = node->parent)
+    if (node == node->parent->right) rank += SIZE(node->parent->left) + 1;
+  return rank;
+}
+
+/* the first node whose key is not less than key */
+WbtNode *wbt_lower_bound(const WBTree *tree, void *key) {
+  if (!wbt_valid(tree)) return NULL;
+  WbtNode *node = tree->root, *bound = NULL;
+  while (node) {
+    if (tree->key_compare(node->key, key) >= 0) {
+      bound = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return bound;
+}
+
+/* the first node whose key is greater than key */
+WbtNode *wbt_upper_bound(const WBTree *tree, void *key) {
+  if (!wbt_valid(tree)) return NULL;
+  WbtNode *node = tree->root, *bound = NULL;
+  while (node) {
+    if (tree->key_compare(node->key, key) > 0) {
+      bound = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return bound;
+}
+
+/* the number of keys in [low, high) in O(log n); a NULL bound is open */
+size_t wbt_count_range(const WBTree *tree, void *low, void *high) {
+  if (!wbt_valid(tree)) return 0;
+  size_t start = low ? wbt_rank(tree, low) : 0;
+  size_t end = high ? wbt_rank(tree, high) : SIZE(tree->root);
+  return end > start ? end - start : 0;
+}
+
+WbtNode *wbt_first(const WBTree *tree) {
+  if (!wbt_valid(tree)) return NULL;
+  return leftmost(tree->root);
+}
+
+WbtNode *wbt_last(const WBTree *tree) {
+  if (!wbt_valid(tree)) return NULL;
+  return rightmost(tree->root);
+}
+
+WbtNode *wbt_next(const WbtNode *node) {
+  if (node == NULL) return NULL;
+  if (node->right) return leftmost(node->right);
+  while (node->parent && node == node->parent->right) node = node->parent;
+  return node->parent;
+}
+
+WbtNode *wbt_prev(const WbtNode *node) {
+  if (node == NULL) return NULL;
+  if (node->left) return rightmost(node->left);
+  while (node->parent && node == node->parent->left) node = node->parent;
+  return node->parent;
+}
+
+/* starts range at the keys in [low, high); a NULL bound is open. The tree
+ * must not be modified while the range is in use.
+ */
+int wbt_range(const WBTree *tree, WbtRange *range, void *low, void *high) {
+  if (!wbt_valid(tree)) {
+    return -1;
+  } else if (range == NULL) {
+    last_status = BLIB_UNINITIALIZED_ARG;
+    return -1;
+  }
+  range->next = low ? wbt_lower_bound(tree, low) : leftmost(tree->root);
+  range->end = high ? wbt_lower_bound(tree, high) : NULL;
+  if (low && high && tree->key_compare(low, high) >= 0)
+    range->next = range->end;
+  return 0;
+}
+
+WbtNode *wbt_range_next(WbtRange *range) {
+  if (range->next == range->end) return NULL;
+  WbtNode *node = range->next;
+  range->next = wbt_next(node);
+  return node;
+}
+
+void wbt_foreach(WBTree *tree, void (*fn)(void *, void *)) {
+  if (!wbt_valid(tree) || !fn) return;
+  WbtNode *node;
+  for (node = leftmost(tree->root); node; node = wbt_next(node))
+    fn(node->key, node->value);
+}
+
+size_t wbt_size(const WBTree *tree) { return SIZE(tree->root); }
+int wbt_empty(const WBTree *tree) { return tree->root == NULL; }
+int wbt_status(const WBTree *tree) {
+  (void)wbt_valid(tree);
+  return last_status;
+}
@@ -0,0 +1,95 @@
+#ifndef __BADWBT_H__
+#define __BADWBT_H__
+#include <stddef.h>
+
+#include "badalist.h"
+#include "badlib.h"
+
+/* number of nodes allocated at a time for a tree's node pool */
+#ifndef BLIB_WBT_CHUNK
+#define BLIB_WBT_CHUNK 64
+#endif
+
+typedef struct wbt_node {
+  struct wbt_node *left;
+  struct wbt_node *right;
+  struct wbt_node *parent;
+  size_t size;
+  void *key;
+  void *value;
+} WbtNode;
+
+typedef struct wbt_chunk {
+  struct wbt_chunk *next;
+  WbtNode nodes[BLIB_WBT_CHUNK];
+} WbtChunk;
+
+/* An ordered map, or a set when every value is NULL, kept balanced by
+ * subtree weight: neither child of a node may outweigh the other by more
+ * than a factor of three. Each node records the size of its subtree, so the
+ * i-th key and the rank of a key are found in O(log n) along with inserts,
+ * deletes and bounds. key_compare returns a negative, zero or positive value
+ * like strcmp.
+ *
+ * Nodes come from a pool of chunks owned by the tree, and are recycled
+ * through a free list threaded through their right pointers. WbtNode
+ * pointers returned by the functions below act as iterators: they stay valid
+ * until their key is deleted, except that deleting a key with two children
+ * moves its successor's key and value into its node.
+ */
+typedef struct wbt {
+  WbtNode *root;
+  WbtNode *free_nodes;
+  WbtChunk *chunks;
+  BlibDestroyer key_destroy;
+  BlibDestroyer value_destroy;
+  BlibComparator key_compare;
+  const BlibAllocator *allocator;
+} WBTree;
+
+/* an in-order walk over the nodes of a key range */
+typedef struct wbt_range {
+  WbtNode *next;
+  WbtNode *end;
+} WbtRange;
+
+int wbt_init(WBTree *tree, BlibDestroyer key_dest, BlibDestroyer value_dest,
+             BlibComparator key_comp);
+int wbt_init_alloc(WBTree *tree, BlibDestroyer key_dest,
+                   BlibDestroyer value_dest, BlibComparator key_comp,
+                   const BlibAllocator *allocator);
+int wbt_from_alist(WBTree *tree, ArrayList *keys, ArrayList *values,
+                   BlibDestroyer key_dest, BlibDestroyer value_dest,
+                   BlibComparator key_comp);
+int wbt_from_alist_alloc(WBTree *tree, ArrayList *keys, ArrayList *values,
+                         BlibDestroyer key_dest, BlibDestroyer value_dest,
+                         BlibComparator key_comp,
+                         const BlibAllocator *allocator);
+int wbt_destroy(WBTree *tree);
+int wbt_clear(WBTree *tree);
+
+int wbt_insert(WBTree *tree, void *key, void *value);
+int wbt_delete(WBTree *tree, void *key);
+void *wbt_get(const WBTree *tree, void *key);
+WbtNode *wbt_find(const WBTree *tree, void *key);
+int wbt_contains(const WBTree *tree, void *key);
+
+WbtNode *wbt_select(const WBTree *tree, size_t index);
+size_t wbt_rank(const WBTree *tree, void *key);
+size_t wbt_node_rank(const WbtNode *node);
+WbtNode *wbt_lower_bound(const WBTree *tree, void *key);
+WbtNode *wbt_upper_bound(const WBTree *tree, void *key);
+size_t wbt_count_range(const WBTree *tree, void *low, void *high);
+
+WbtNode *wbt_first(const WBTree *tree);
+WbtNode *wbt_last(const WBTree *tree);
+WbtNode *wbt_next(const WbtNode *node);
+WbtNode *wbt_prev(const WbtNode *node);
+int wbt_range(const WBTree *tree, WbtRange *range, void *low, void *high);
+WbtNode *wbt_range_next(WbtRange *range);
+void wbt_foreach(WBTree *tree, void (*fn)(void *, void *));
+
+size_t wbt_size(const WBTree *tree);
+int wbt_empty(const WBTree *tree);
+int wbt_status(const WBTree *tree);
+#endif
@@ -0,0 +1,164 @@
+/* Multi-producer, multi-consumer throughput benchmark for the concurrent
+ * queues, against a LinkedList behind a mutex. The SPSC ring is included
+ * when there is one producer and one consumer. Usage:
+ *   ./bench [producers] [consumers] [items per producer]
+ */
+#define _POSIX_C_SOURCE 199309L
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "badllist.h"
+#include "badmpmc.h"
+#include "badspsc.h"
+
+typedef struct bench {
+  const char *name;
+  int (*push)(void *queue, void *element);
+  void *(*pop)(void *queue);
+  void *queue;
+  size_t per_producer;
+  size_t total;
+  size_t consumed;
+  size_t checksum;
+} Bench;
+
+typedef struct locked_list {
+  LinkedList list;
+  pthread_mutex_t lock;
+} LockedList;
+
+static int locked_push(void *queue, void *element) {
+  LockedList *locked = queue;
+  pthread_mutex_lock(&locked->lock);
+  int status = llist_push_back(&locked->list, element);
+  pthread_mutex_unlock(&locked->lock);
+  return status;
+}
+
+static void *locked_pop(void *queue) {
+  LockedList *locked = queue;
+  pthread_mutex_lock(&locked->lock);
+  void *element = llist_empty(&locked->list) ? NULL
+                                             : llist_pop_front(&locked->list);
+  pthread_mutex_unlock(&locked->lock);
+  return element;
+}
+
+static int mpmc_push(void *queue, void *element) {
+  return mpmc_push_back(queue, element);
+}
+static void *mpmc_pop(void *queue) { return mpmc_pop_front(queue); }
+static int msq_push(void *queue, void *element) {
+  return msq_push_back(queue, element);
+}
+static void *msq_pop(void *queue) { return msq_pop_front(queue); }
+static int spsc_push_one(void *queue, void *element) {
+  return spsc_try_push(queue, element);
+}
+static void *spsc_pop_one(void *queue) { return spsc_try_pop(queue); }
+
+/* elements are the integers from 1, disguised as pointers */
+static void *producer(void *arg) {
+  Bench *bench = arg;
+  size_t i;
+  for (i = 1; i <= bench->per_producer; ++i)
+    while (bench->push(bench->queue, (void *)i)) continue;
+  return NULL;
+}
+
+/* counts are published in batches, and always before checking for the end */
+static void *consumer(void *arg) {
+  Bench *bench = arg;
+  size_t sum = 0, count = 0;
+  for (;;) {
+    void *element = bench->pop(bench->queue);
+    if (element) {
+      sum += (size_t)element;
+      ++count;
+    }
+    if (count == 1024 || !element) {
+      __atomic_add_fetch(&bench->checksum, sum, __ATOMIC_RELAXED);
+      size_t consumed =
+          __atomic_add_fetch(&bench->consumed, count, __ATOMIC_RELAXED);
+      if (!element && consumed >= bench->total) break;
+      count = sum = 0;
+    }
+  }
+  return NULL;
+}
+
+static void run(Bench *bench, int producers, int consumers) {
+  pthread_t *threads = malloc(sizeof(pthread_t) * (producers + consumers));
+  struct timespec start, end;
+  int i;
+  bench->total = bench->per_producer * producers;
+  bench->consumed = bench->checksum = 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0; i < producers; ++i)
+    pthread_create(threads + i, NULL, producer, bench);
+  for (i = 0; i < consumers; ++i)
+    pthread_create(threads + producers + i, NULL, consumer, bench);
+  for (i = 0; i < producers + consumers; ++i) pthread_join(threads[i], NULL);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double seconds =
+      (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  size_t expected = bench->per_producer * (bench->per_producer + 1) / 2;
+  printf("%-16s %10.0f ops/s %s\n", bench->name, bench->total / seconds,
+         bench->checksum == expected * producers ? "" : "(checksum mismatch)");
+  free(threads);
+}
+
+int main(int argc, char **argv) {
+  int producers = argc > 1 ? atoi(argv[1]) : 4;
+  int consumers = argc > 2 ? atoi(argv[2]) : 4;
+  size_t per_producer = argc > 3 ? strtoul(argv[3], NULL, 10) : 1000000;
+  Bench bench;
+  bench.per_producer = per_producer;
+  printf("%d producers, %d consumers, %lu items each\n", producers, consumers,
+         (unsigned long)per_producer);
+
+  LockedList locked;
+  llist_init(&locked.list, NULL, NULL);
+  pthread_mutex_init(&locked.lock, NULL);
+  bench.name = "mutex llist";
+  bench.push = locked_push;
+  bench.pop = locked_pop;
+  bench.queue = &locked;
+  run(&bench, producers, consumers);
+  llist_destroy(&locked.list);
+  pthread_mutex_destroy(&locked.lock);
+
+  MpmcQueue mpmc;
+  mpmc_init(&mpmc, 1 << 14);
+  bench.name = "bounded mpmc";
+  bench.push = mpmc_push;
+  bench.pop = mpmc_pop;
+  bench.queue = &mpmc;
+  run(&bench, producers, consumers);
+  mpmc_destroy(&mpmc, NULL);
+
+  MsQueue msq;
+  msq_init(&msq);
+  bench.name = "michael-scott";
+  bench.push = msq_push;
+  bench.pop = msq_pop;
+  bench.queue = &msq;
+  run(&bench, producers, consumers);
+  msq_destroy(&msq, NULL);
+
+  /* the SPSC ring is only correct with one thread on each side */
+  if (producers != 1 || consumers != 1) return 0;
+  SpscRing spsc;
+  spsc_init(&spsc, 1 << 14);
+  bench.name = "spsc ring";
+  bench.push = spsc_push_one;
+  bench.pop = spsc_pop_one;
+  bench.queue = &spsc;
+  run(&bench, producers, consumers);
+  spsc_destroy(&spsc, NULL);
+  return 0;
+}
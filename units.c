@@ -1,11 +1,30 @@
 #include <CUnit/Basic.h>
+#include <pthread.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "badalist.h"
+#include "badalloc.h"
+#include "badart.h"
+#include "badbpt.h"
+#include "badclist.h"
+#include "baddeque.h"
+#include "badgbuf.h"
+#include "badheap.h"
+#include "badilist.h"
+#include "badintern.h"
 #include "badllist.h"
 #include "badmap.h"
+#include "badmpmc.h"
+#include "badset.h"
+#include "badslotmap.h"
+#include "badspsc.h"
+#include "badtmpl.h"
+#include "badulist.h"
+#include "badvec.h"
+#include "badwbt.h"
 
 typedef struct complicated {
   int *bingus;
@@ -25,6 +44,33 @@ void free_complicated(struct complicated *somedata) {
   free(somedata);
 }
 
+int int_eq(void *a, void *b) { return *(int *)a == *(int *)b; }
+int int_cmp(void *a, void *b) { return *(int *)a - *(int *)b; }
+
+static size_t visited = 0;
+int count_visit(const void *key, size_t key_size, void *value) {
+  (void)key;
+  (void)key_size;
+  (void)value;
+  return ++visited == 100;
+}
+
+static size_t destroyed = 0;
+void count_destroyed(void *data) {
+  (void)data;
+  ++destroyed;
+}
+
+BLIB_ALIST_DECLARE(IntArray, iarr, int)
+BLIB_ALIST_DEFINE(IntArray, iarr, int, BLIB_LESS, BLIB_EQUAL, BLIB_NO_DESTROY)
+BLIB_LLIST_DECLARE(IntQueue, iqueue, int)
+BLIB_LLIST_DEFINE(IntQueue, iqueue, int, BLIB_EQUAL, BLIB_NO_DESTROY)
+BLIB_MAP_DECLARE(IntMap, imap, int, int)
+BLIB_MAP_DEFINE(IntMap, imap, int, int, BLIB_HASH_INT, BLIB_EQUAL,
+                BLIB_NO_DESTROY, BLIB_NO_DESTROY)
+BLIB_SET_DECLARE(IntSet, iset, int)
+BLIB_SET_DEFINE(IntSet, iset, int, BLIB_HASH_INT, BLIB_EQUAL, BLIB_NO_DESTROY)
+
 ArrayList *arraylist = NULL;
 LinkedList *linkedlist = NULL;
 Map *map = NULL;
@@ -140,6 +186,158 @@ void test_llist_sequence(void) {
   free(i);
 }
 
+void test_llist_traversal(void) {
+  LinkedList list, copy;
+  size_t i;
+  CU_ASSERT_EQUAL_FATAL(0, llist_init(&list, NULL, NULL));
+  for (i = 0; i < 1000; ++i)
+    CU_ASSERT_FALSE(llist_push_back(&list, test_data + i % 10));
+
+  /* sequential access resumes from the finger */
+  for (i = 0; i < 1000; ++i)
+    CU_ASSERT_PTR_EQUAL(test_data + i % 10, llist_get(&list, i));
+  CU_ASSERT_EQUAL(999, list.finger_index);
+  CU_ASSERT_PTR_EQUAL(test_data + 3, llist_get(&list, 503));
+  CU_ASSERT_EQUAL(503, list.finger_index);
+  CU_ASSERT_FALSE(llist_delete(&list, 500));
+  CU_ASSERT_PTR_NULL(list.finger);
+  CU_ASSERT_PTR_EQUAL(test_data + 1, llist_get(&list, 500));
+
+  CU_ASSERT_EQUAL(5, llist_find(&list, test_data + 5));
+  CU_ASSERT_EQUAL(994, llist_rfind(&list, test_data + 5));
+  CU_ASSERT_EQUAL((size_t)-1, llist_rfind(&list, test_data + 10));
+  CU_ASSERT_EQUAL(0, llist_copy(&copy, &list));
+  CU_ASSERT_EQUAL(999, llist_size(&copy));
+  CU_ASSERT_PTR_EQUAL(test_data + 9, llist_get(&copy, 998));
+  destroyed = 0;
+  llist_foreach(&copy, count_destroyed);
+  CU_ASSERT_EQUAL(999, destroyed);
+  CU_ASSERT_FALSE(llist_destroy(&copy));
+  CU_ASSERT_FALSE(llist_destroy(&list));
+}
+
+void test_llist_bulk(void) {
+  LinkedList a, b, c;
+  ListIter where, first, end;
+  void *elements[10];
+  size_t i;
+  for (i = 0; i < 10; ++i) elements[i] = test_data + i;
+  CU_ASSERT_EQUAL_FATAL(0, llist_init(&a, NULL, NULL));
+  CU_ASSERT_EQUAL_FATAL(0, llist_init(&b, NULL, NULL));
+
+  /* a = 0 1 2 3 4, b = 5 6 7 8 9 */
+  CU_ASSERT_FALSE(llist_push_back_array(&a, elements, 5));
+  CU_ASSERT_FALSE(liter_init_end(&where, &b));
+  CU_ASSERT_FALSE(liter_insert_array(&where, elements + 7, 3));
+  CU_ASSERT_FALSE(liter_init_begin(&where, &b));
+  CU_ASSERT_FALSE(liter_insert_array(&where, elements + 5, 2));
+  CU_ASSERT_PTR_EQUAL(test_data + 7, liter_get(&where));
+  CU_ASSERT_PTR_EQUAL(test_data + 5, llist_front(&b));
+  CU_ASSERT_EQUAL(5, llist_size(&b));
+
+  /* a = 0 1 2 3 4 5 6 7 8 9, b is empty */
+  CU_ASSERT_FALSE(llist_concat(&a, &b));
+  CU_ASSERT_EQUAL(10, llist_size(&a));
+  CU_ASSERT_TRUE(llist_empty(&b));
+  for (i = 0; i < 10; ++i) CU_ASSERT_PTR_EQUAL(elements[i], llist_get(&a, i));
+
+  /* a = 0 1 2 3, c = 4 5 6 7 8 9 */
+  CU_ASSERT_FALSE(llist_split_at(&a, 4, &c));
+  CU_ASSERT_EQUAL(4, llist_size(&a));
+  CU_ASSERT_EQUAL(6, llist_size(&c));
+  CU_ASSERT_PTR_EQUAL(test_data + 4, llist_front(&c));
+  CU_ASSERT_PTR_EQUAL(test_data + 3, llist_back(&a));
+
+  /* move 5 6 7 between 0 and 1 in a */
+  CU_ASSERT_FALSE(liter_init_at(&where, &a, 1));
+  CU_ASSERT_FALSE(liter_init_at(&first, &c, 1));
+  CU_ASSERT_FALSE(liter_init_at(&end, &c, 4));
+  CU_ASSERT_FALSE(llist_splice_range(&where, &first, &end));
+  CU_ASSERT_EQUAL(7, llist_size(&a));
+  CU_ASSERT_EQUAL(3, llist_size(&c));
+  CU_ASSERT_PTR_EQUAL(test_data + 5, llist_get(&a, 1));
+  CU_ASSERT_PTR_EQUAL(test_data + 1, llist_get(&a, 4));
+  CU_ASSERT_PTR_EQUAL(test_data + 8, llist_get(&c, 1));
+
+  /* within one list, move 0 5 to the back: a = 6 7 1 2 3 0 5 */
+  CU_ASSERT_FALSE(liter_init_end(&where, &a));
+  CU_ASSERT_FALSE(liter_init_begin(&first, &a));
+  CU_ASSERT_FALSE(liter_init_at(&end, &a, 2));
+  CU_ASSERT_FALSE(llist_splice_range(&where, &first, &end));
+  CU_ASSERT_EQUAL(7, llist_size(&a));
+  CU_ASSERT_PTR_EQUAL(test_data + 6, llist_front(&a));
+  CU_ASSERT_PTR_EQUAL(test_data + 5, llist_back(&a));
+  CU_ASSERT_TRUE(llist_splice(&where, &a));
+
+  /* ranges over the anchor or around where are refused untouched */
+  CU_ASSERT_FALSE(liter_init_at(&first, &a, 5));
+  CU_ASSERT_FALSE(liter_init_at(&end, &a, 1));
+  CU_ASSERT_FALSE(liter_init_at(&where, &a, 3));
+  CU_ASSERT_TRUE(llist_splice_range(&where, &first, &end));
+  CU_ASSERT_EQUAL(BLIB_OUT_OF_BOUNDS, llist_status(&a));
+  CU_ASSERT_FALSE(liter_init_end(&first, &a));
+  CU_ASSERT_TRUE(llist_splice_range(&where, &first, &end));
+  CU_ASSERT_FALSE(liter_init_begin(&first, &a));
+  CU_ASSERT_FALSE(liter_init_at(&end, &a, 4));
+  CU_ASSERT_TRUE(llist_splice_range(&where, &first, &end));
+  where.list = NULL;
+  CU_ASSERT_TRUE(llist_splice_range(&where, &first, &end));
+  CU_ASSERT_EQUAL(7, llist_size(&a));
+  size_t order[7] = {6, 7, 1, 2, 3, 0, 5};
+  for (i = 0; i < 7; ++i)
+    CU_ASSERT_PTR_EQUAL(test_data + order[i], llist_get(&a, i));
+
+  CU_ASSERT_FALSE(llist_destroy(&a));
+  CU_ASSERT_FALSE(llist_destroy(&b));
+  CU_ASSERT_FALSE(llist_destroy(&c));
+}
+
+struct keyed {
+  int key;
+  int seq;
+};
+
+int keyed_cmp(void *a, void *b) {
+  return ((struct keyed *)a)->key - ((struct keyed *)b)->key;
+}
+
+void test_llist_sort(void) {
+  LinkedList list;
+  static struct keyed items[3000];
+  size_t i;
+  CU_ASSERT_EQUAL_FATAL(0, llist_init(&list, NULL, NULL));
+  for (i = 0; i < 3000; ++i) {
+    items[i].key = i * 7919 % 100;
+    items[i].seq = i;
+    CU_ASSERT_FALSE(llist_push_back(&list, items + i));
+  }
+  CU_ASSERT_EQUAL(1, llist_sort(&list, NULL));
+  CU_ASSERT_FALSE(llist_sort(&list, keyed_cmp));
+  CU_ASSERT_EQUAL(3000, llist_size(&list));
+
+  /* equal keys keep their original order */
+  Node *node;
+  for (node = list.anchor->next; node->next != list.anchor; node = node->next) {
+    struct keyed *a = node->data, *b = node->next->data;
+    CU_ASSERT_TRUE(a->key < b->key || (a->key == b->key && a->seq < b->seq));
+    CU_ASSERT_PTR_EQUAL(node, node->next->prev);
+  }
+  CU_ASSERT_PTR_EQUAL(node, list.anchor->prev);
+
+  /* sorted and reverse sorted input are single runs */
+  CU_ASSERT_FALSE(llist_sort(&list, keyed_cmp));
+  CU_ASSERT_EQUAL(0, ((struct keyed *)llist_front(&list))->key);
+  llist_clear(&list);
+  for (i = 0; i < 100; ++i) {
+    items[i].key = i;
+    llist_push_front(&list, items + i);
+  }
+  CU_ASSERT_FALSE(llist_sort(&list, keyed_cmp));
+  for (i = 0; i < 100; ++i)
+    CU_ASSERT_EQUAL((int)i, ((struct keyed *)llist_get(&list, i))->seq);
+  CU_ASSERT_FALSE(llist_destroy(&list));
+}
+
 void test_liter_creation(void) {
   ListIter *begin_iter = llist_iter_begin(linkedlist);
   CU_ASSERT_PTR_NOT_NULL(begin_iter);
@@ -199,6 +397,62 @@ void test_liter_iteration(void) {
   free(iter);
 }
 
+void test_liter_push_front(void) {
+  LinkedList list;
+  int three = 3, a = 1, b = 2;
+  CU_ASSERT_FALSE(llist_init(&list, NULL, NULL));
+  CU_ASSERT_FALSE(llist_push_back(&list, &three));
+
+  /* inserting at the head, with a separate output iterator */
+  ListIter *iter = llist_iter_begin(&list);
+  ListIter *out = NULL;
+  CU_ASSERT_FALSE(liter_push_front(iter, &out, 2, &a, &b));
+  CU_ASSERT_PTR_NOT_NULL_FATAL(out);
+  CU_ASSERT_PTR_EQUAL(&a, liter_get(out));
+  CU_ASSERT_PTR_EQUAL(&three, liter_get(iter));
+  CU_ASSERT_EQUAL(3, llist_size(&list));
+  CU_ASSERT_PTR_EQUAL(&a, llist_get(&list, 0));
+  CU_ASSERT_PTR_EQUAL(&b, llist_get(&list, 1));
+  free(out);
+  free(iter);
+
+  /* and with iter itself as the output */
+  iter = llist_iter_begin(&list);
+  out = iter;
+  CU_ASSERT_FALSE(liter_push_front(iter, &out, 2, &b, &a));
+  CU_ASSERT_PTR_EQUAL(iter, out);
+  CU_ASSERT_PTR_EQUAL(&b, liter_get(iter));
+  CU_ASSERT_EQUAL(5, llist_size(&list));
+  CU_ASSERT_PTR_EQUAL(&a, llist_get(&list, 1));
+  CU_ASSERT_PTR_EQUAL(&a, llist_get(&list, 2));
+  free(iter);
+  CU_ASSERT_FALSE(llist_destroy(&list));
+}
+
+void test_liter_values(void) {
+  ListIter iter, end;
+  size_t count = 0;
+  CU_ASSERT_FALSE(liter_init_begin(&iter, linkedlist));
+  CU_ASSERT_FALSE(liter_init_end(&end, linkedlist));
+  for (; !liter_end(&iter); ++count) {
+    CU_ASSERT_PTR_EQUAL(llist_get(linkedlist, count), liter_get(&iter));
+    CU_ASSERT_FALSE(liter_inc(&iter));
+  }
+  CU_ASSERT_EQUAL(llist_size(linkedlist), count);
+  CU_ASSERT_PTR_EQUAL(end.node, iter.node);
+  CU_ASSERT_TRUE(liter_inc(&iter));
+  CU_ASSERT_EQUAL(BLIB_OUT_OF_BOUNDS, llist_status(linkedlist));
+
+  /* stepping back from the end reaches the last element */
+  CU_ASSERT_FALSE(liter_dec(&iter));
+  CU_ASSERT_FALSE(liter_init_last(&end, linkedlist));
+  CU_ASSERT_PTR_EQUAL(end.node, iter.node);
+  CU_ASSERT_FALSE(liter_init_at(&iter, linkedlist, 1));
+  CU_ASSERT_PTR_EQUAL(llist_get(linkedlist, 1), liter_get(&iter));
+  CU_ASSERT_TRUE(liter_init_at(&iter, linkedlist, count + 1));
+  CU_ASSERT_TRUE(liter_init_begin(NULL, linkedlist));
+}
+
 int init_alist_suite(void) {
   if (NULL == (arraylist = malloc(sizeof(*arraylist))) ||
       alist_init(arraylist, 10))
@@ -363,6 +617,1359 @@ void test_alist_stack(void) {
   CU_ASSERT_EQUAL(0, alist_count(arraylist));
 }
 
+void test_alist_scan(void) {
+  ArrayList list;
+  CU_ASSERT_EQUAL_FATAL(0, alist_init(&list, 100));
+  CU_ASSERT_EQUAL(0, alist_count(&list));
+  CU_ASSERT_EQUAL(100, alist_first_index(&list));
+  CU_ASSERT_EQUAL(100, alist_last_index(&list));
+  CU_ASSERT_EQUAL(100, alist_find(&list, test_data, NULL));
+
+  /* sparse elements, some of them in the tail past the last 8-slot block */
+  size_t i;
+  for (i = 3; i < 100; i += 13)
+    CU_ASSERT_EQUAL(0, alist_insert(&list, test_data + i % 10, i, NULL));
+  CU_ASSERT_EQUAL(8, alist_count(&list));
+  CU_ASSERT_EQUAL(3, alist_first_index(&list));
+  CU_ASSERT_EQUAL(94, alist_last_index(&list));
+  CU_ASSERT_EQUAL(29, alist_find(&list, test_data + 9, NULL));
+  CU_ASSERT_EQUAL(94, alist_rfind(&list, test_data + 4, NULL));
+  CU_ASSERT_EQUAL(68, alist_rfind(&list, test_data + 8, NULL));
+  CU_ASSERT_EQUAL(100, alist_find(&list, test_data + 7, NULL));
+  CU_ASSERT_EQUAL(100, alist_find(&list, NULL, NULL));
+
+  CU_ASSERT_EQUAL(0, alist_delete(&list, 94, NULL));
+  CU_ASSERT_EQUAL(81, alist_last_index(&list));
+  CU_ASSERT_EQUAL(100, alist_rfind(&list, test_data + 4, NULL));
+  CU_ASSERT_EQUAL(0, alist_destroy(&list, NULL));
+}
+
+void test_alist_capacity(void) {
+  ArrayList list;
+  CU_ASSERT_EQUAL_FATAL(0, alist_init(&list, 0));
+  CU_ASSERT_EQUAL(0, alist_reserve(&list, 100));
+  CU_ASSERT_EQUAL(100, alist_cap(&list));
+  CU_ASSERT_EQUAL(0, alist_size(&list));
+  size_t i;
+  for (i = 0; i < 101; ++i) CU_ASSERT_EQUAL(0, alist_push(&list, test_data));
+  CU_ASSERT_EQUAL(200, alist_cap(&list));
+  CU_ASSERT_EQUAL(0, alist_shrink_to_fit(&list));
+  CU_ASSERT_EQUAL(101, alist_cap(&list));
+
+  /* grow by half until 150, then by chunks of 64 */
+  CU_ASSERT_NOT_EQUAL(0, alist_set_growth(&list, 100, 0, 0));
+  CU_ASSERT_EQUAL(BLIB_INVALID_SIZE, alist_status(&list));
+  CU_ASSERT_EQUAL(0, alist_set_growth(&list, 150, 150, 64));
+  CU_ASSERT_EQUAL(0, alist_push(&list, test_data));
+  CU_ASSERT_EQUAL(151, alist_cap(&list));
+  for (i = 0; i < 50; ++i) CU_ASSERT_EQUAL(0, alist_push(&list, test_data));
+  CU_ASSERT_EQUAL(215, alist_cap(&list));
+  CU_ASSERT_EQUAL(0, alist_resize(&list, 300, NULL));
+  CU_ASSERT_EQUAL(343, alist_cap(&list));
+  CU_ASSERT_EQUAL(152, alist_count(&list));
+
+  /* large enough to be mapped instead of malloc'd */
+  size_t large = ((size_t)80 << 20) / sizeof(void *);
+  CU_ASSERT_EQUAL(0, alist_reserve(&list, large));
+  CU_ASSERT_EQUAL(0, alist_push(&list, test_data + 1));
+  CU_ASSERT_EQUAL(0, alist_reserve(&list, large * 2));
+  CU_ASSERT_EQUAL(large * 2, alist_cap(&list));
+  CU_ASSERT_EQUAL(153, alist_count(&list));
+  CU_ASSERT_PTR_EQUAL(test_data + 1, alist_get(&list, 300));
+  CU_ASSERT_EQUAL(0, alist_shrink_to_fit(&list));
+  CU_ASSERT_EQUAL(301, alist_cap(&list));
+  CU_ASSERT_PTR_EQUAL(test_data + 1, alist_peek(&list));
+  CU_ASSERT_EQUAL(153, alist_count(&list));
+  CU_ASSERT_EQUAL(0, alist_destroy(&list, NULL));
+}
+
+void test_alist_small(void) {
+  ArrayList list;
+  CU_ASSERT_EQUAL_FATAL(0, alist_init(&list, 0));
+  CU_ASSERT_PTR_EQUAL(list.small, list.data);
+  size_t i;
+  for (i = 0; i < BLIB_ALIST_SMALL_CAP; ++i)
+    CU_ASSERT_EQUAL(0, alist_push(&list, test_data + i));
+  CU_ASSERT_PTR_EQUAL(list.small, list.data);
+  CU_ASSERT_EQUAL(BLIB_ALIST_SMALL_CAP, alist_cap(&list));
+
+  /* outgrow the embedded buffer, then shrink back into it */
+  CU_ASSERT_EQUAL(0, alist_push(&list, test_data + 8));
+  CU_ASSERT_PTR_NOT_EQUAL(list.small, list.data);
+  for (i = 0; i <= BLIB_ALIST_SMALL_CAP; ++i)
+    CU_ASSERT_PTR_EQUAL(test_data + i, alist_get(&list, i));
+  CU_ASSERT_EQUAL(0, alist_resize(&list, 3, NULL));
+  CU_ASSERT_PTR_EQUAL(list.small, list.data);
+  CU_ASSERT_EQUAL(4, alist_cap(&list));
+  for (i = 0; i < 3; ++i)
+    CU_ASSERT_PTR_EQUAL(test_data + i, alist_get(&list, i));
+  CU_ASSERT_EQUAL(0, alist_destroy(&list, NULL));
+}
+
+void test_alist_compact(void) {
+  ArrayList list;
+  size_t i, remap[100];
+  CU_ASSERT_EQUAL_FATAL(0, alist_init(&list, 100));
+  for (i = 0; i < 100; i += 3)
+    CU_ASSERT_EQUAL(0, alist_insert(&list, test_data + i % 10, i, NULL));
+  CU_ASSERT_EQUAL(34, alist_count(&list));
+  CU_ASSERT_EQUAL(0, alist_first_index(&list));
+  CU_ASSERT_EQUAL(99, alist_last_index(&list));
+  CU_ASSERT_EQUAL(0, alist_delete(&list, 0, NULL));
+  CU_ASSERT_EQUAL(0, alist_delete(&list, 99, NULL));
+  CU_ASSERT_EQUAL(32, alist_count(&list));
+  CU_ASSERT_EQUAL(3, alist_first_index(&list));
+  CU_ASSERT_EQUAL(96, alist_last_index(&list));
+  CU_ASSERT_EQUAL(9, alist_find(&list, test_data + 9, int_eq));
+  CU_ASSERT_EQUAL(93, alist_rfind(&list, test_data + 3, int_eq));
+
+  /* holes are squeezed out and the surviving elements keep their order */
+  CU_ASSERT_EQUAL(0, alist_compact(&list, remap));
+  CU_ASSERT_EQUAL(32, alist_size(&list));
+  CU_ASSERT_EQUAL(32, alist_count(&list));
+  CU_ASSERT_EQUAL((size_t)-1, remap[0]);
+  CU_ASSERT_EQUAL((size_t)-1, remap[4]);
+  for (i = 3; i < 99; i += 3) {
+    CU_ASSERT_EQUAL(i / 3 - 1, remap[i]);
+    CU_ASSERT_PTR_EQUAL(test_data + i % 10, alist_get(&list, remap[i]));
+  }
+  CU_ASSERT_EQUAL(31, alist_last_index(&list));
+
+  /* with a threshold, deletions compact the list on their own */
+  CU_ASSERT_EQUAL(-1, alist_set_compaction(&list, 101));
+  CU_ASSERT_EQUAL(0, alist_set_compaction(&list, 50));
+  for (i = 0; i < 16; ++i) CU_ASSERT_EQUAL(0, alist_delete(&list, i, NULL));
+  CU_ASSERT_EQUAL(32, alist_size(&list));
+  CU_ASSERT_EQUAL(0, alist_delete(&list, 16, NULL));
+  CU_ASSERT_EQUAL(15, alist_size(&list));
+  CU_ASSERT_EQUAL(15, alist_count(&list));
+  CU_ASSERT_EQUAL(0, alist_destroy(&list, NULL));
+}
+
+void test_alist_range(void) {
+  ArrayList a, b;
+  void *elements[10];
+  size_t i;
+  for (i = 0; i < 10; ++i) elements[i] = test_data + i;
+  CU_ASSERT_EQUAL_FATAL(0, alist_init(&a, 0));
+  CU_ASSERT_EQUAL_FATAL(0, alist_init(&b, 0));
+
+  /* a = 0 1 7 8 9 2 3 4 5 6 */
+  CU_ASSERT_EQUAL(0, alist_append_range(&a, elements, 7));
+  CU_ASSERT_EQUAL(0, alist_insert_range(&a, 2, elements + 7, 3));
+  CU_ASSERT_EQUAL(-1, alist_insert_range(&a, 11, elements, 1));
+  CU_ASSERT_EQUAL(10, alist_size(&a));
+  CU_ASSERT_EQUAL(10, alist_count(&a));
+  CU_ASSERT_PTR_EQUAL(test_data + 1, alist_get(&a, 1));
+  CU_ASSERT_PTR_EQUAL(test_data + 9, alist_get(&a, 4));
+  CU_ASSERT_PTR_EQUAL(test_data + 2, alist_get(&a, 5));
+  CU_ASSERT_PTR_EQUAL(test_data + 6, alist_get(&a, 9));
+
+  /* the destroyer runs once per element removed, skipping holes */
+  destroyed = 0;
+  CU_ASSERT_EQUAL(0, alist_delete(&a, 3, NULL));
+  CU_ASSERT_EQUAL(0, alist_erase_range(&a, 1, 6, count_destroyed));
+  CU_ASSERT_EQUAL(4, destroyed);
+  CU_ASSERT_EQUAL(5, alist_size(&a));
+  CU_ASSERT_EQUAL(5, alist_count(&a));
+  CU_ASSERT_PTR_EQUAL(test_data + 3, alist_get(&a, 1));
+  CU_ASSERT_EQUAL(4, alist_last_index(&a));
+
+  /* b = 0 3 4 5 6 0 1 2 3 4, then move the middle back into a */
+  CU_ASSERT_EQUAL(0, alist_splice(&b, 0, &a, 0, 5));
+  CU_ASSERT_EQUAL(0, alist_size(&a));
+  CU_ASSERT_EQUAL(0, alist_count(&a));
+  CU_ASSERT_EQUAL(0, alist_append_range(&b, elements, 5));
+  CU_ASSERT_EQUAL(-1, alist_splice(&b, 0, &b, 0, 1));
+  CU_ASSERT_EQUAL(0, alist_splice(&a, 0, &b, 3, 7));
+  CU_ASSERT_EQUAL(6, alist_size(&b));
+  CU_ASSERT_EQUAL(4, alist_size(&a));
+  CU_ASSERT_PTR_EQUAL(test_data + 5, alist_get(&a, 0));
+  CU_ASSERT_PTR_EQUAL(test_data + 1, alist_get(&a, 3));
+  CU_ASSERT_PTR_EQUAL(test_data + 4, alist_get(&b, 2));
+  CU_ASSERT_PTR_EQUAL(test_data + 2, alist_get(&b, 3));
+  CU_ASSERT_EQUAL(6, alist_count(&b));
+  CU_ASSERT_EQUAL(0, alist_destroy(&a, NULL));
+  CU_ASSERT_EQUAL(0, alist_destroy(&b, NULL));
+}
+
+void test_smap_handles(void) {
+  SlotMap map;
+  SlotHandle handles[100];
+  size_t i;
+  CU_ASSERT_EQUAL_FATAL(0, smap_init(&map, NULL));
+  for (i = 0; i < 100; ++i) {
+    handles[i] = smap_insert(&map, test_data + i % 10);
+    CU_ASSERT_NOT_EQUAL(BLIB_SMAP_NULL, handles[i]);
+  }
+  CU_ASSERT_EQUAL(100, smap_size(&map));
+  CU_ASSERT_PTR_EQUAL(test_data + 7, smap_get(&map, handles[57]));
+
+  /* removed handles go stale, even once their slots are reused */
+  for (i = 0; i < 100; i += 2)
+    CU_ASSERT_EQUAL(0, smap_remove(&map, handles[i]));
+  CU_ASSERT_EQUAL(-1, smap_remove(&map, handles[0]));
+  CU_ASSERT_EQUAL(50, smap_size(&map));
+  SlotHandle reused = smap_insert(&map, test_data);
+  CU_ASSERT_EQUAL((uint32_t)handles[98], (uint32_t)reused);
+  CU_ASSERT_NOT_EQUAL(handles[98], reused);
+  CU_ASSERT_PTR_NULL(smap_get(&map, handles[98]));
+  CU_ASSERT_EQUAL(W_BLIB_NOT_FOUND, smap_status(&map));
+  CU_ASSERT_FALSE(smap_contains(&map, BLIB_SMAP_NULL));
+  CU_ASSERT_PTR_EQUAL(test_data, smap_get(&map, reused));
+  for (i = 1; i < 100; i += 2)
+    CU_ASSERT_PTR_EQUAL(test_data + i % 10, smap_get(&map, handles[i]));
+
+  /* the dense array holds exactly the live values */
+  for (i = 0; i < smap_size(&map); ++i) {
+    SlotHandle handle = smap_handle_at(&map, i);
+    CU_ASSERT_PTR_EQUAL(smap_value_at(&map, i), smap_get(&map, handle));
+  }
+  CU_ASSERT_EQUAL(0, smap_set(&map, reused, test_data + 1));
+  CU_ASSERT_PTR_EQUAL(test_data + 1, smap_get(&map, reused));
+  CU_ASSERT_EQUAL(0, smap_clear(&map));
+  CU_ASSERT_TRUE(smap_empty(&map));
+  CU_ASSERT_FALSE(smap_contains(&map, handles[1]));
+  CU_ASSERT_EQUAL(0, smap_destroy(&map));
+}
+
+void test_gbuf_edits(void) {
+  GapBuffer buf;
+  void *shadow[1000], *run[3];
+  size_t i, size = 10, cursor = 5;
+  CU_ASSERT_EQUAL_FATAL(0, gbuf_init(&buf, 0));
+  for (i = 0; i < size; ++i) {
+    shadow[i] = test_data + i;
+    CU_ASSERT_EQUAL(0, gbuf_push(&buf, shadow[i]));
+  }
+
+  /* type and backspace around a wandering cursor, mirrored in shadow */
+  for (i = 0; i < 300; ++i) {
+    run[0] = run[1] = run[2] = test_data + i % 10;
+    if (i % 7 == 0) cursor = (cursor * 31 + 17) % (size + 1);
+    if (i % 5 == 4 && cursor > 0) {
+      --cursor;
+      CU_ASSERT_EQUAL(0, gbuf_delete(&buf, cursor, NULL));
+      memmove(shadow + cursor, shadow + cursor + 1,
+              sizeof(void *) * (--size - cursor));
+    } else {
+      CU_ASSERT_EQUAL(0, gbuf_insert_range(&buf, cursor, run, 3));
+      memmove(shadow + cursor + 3, shadow + cursor,
+              sizeof(void *) * (size - cursor));
+      memcpy(shadow + cursor, run, sizeof(run));
+      size += 3;
+      cursor += 3;
+    }
+  }
+  CU_ASSERT_EQUAL_FATAL(size, gbuf_size(&buf));
+  for (i = 0; i < size; ++i) CU_ASSERT_PTR_EQUAL(shadow[i], gbuf_get(&buf, i));
+
+  CU_ASSERT_EQUAL(0, gbuf_move_gap(&buf, 0));
+  CU_ASSERT_EQUAL(-1, gbuf_move_gap(&buf, size + 1));
+  CU_ASSERT_EQUAL(0, gbuf_erase_range(&buf, 1, size - 1, NULL));
+  CU_ASSERT_EQUAL(2, gbuf_size(&buf));
+  CU_ASSERT_PTR_EQUAL(shadow[0], gbuf_get(&buf, 0));
+  CU_ASSERT_PTR_EQUAL(shadow[size - 1], gbuf_get(&buf, 1));
+  CU_ASSERT_EQUAL(0, gbuf_set(&buf, test_data + 9, 0, NULL));
+  CU_ASSERT_EQUAL(0, gbuf_find(&buf, test_data + 9, NULL));
+  CU_ASSERT_EQUAL(0, gbuf_pop(&buf, NULL));
+  CU_ASSERT_EQUAL(0, gbuf_pop(&buf, NULL));
+  CU_ASSERT_EQUAL(-1, gbuf_pop(&buf, NULL));
+  CU_ASSERT_TRUE(gbuf_empty(&buf));
+  CU_ASSERT_EQUAL(0, gbuf_destroy(&buf, NULL));
+}
+
+void test_ulist_edits(void) {
+  UnrolledList list;
+  void *shadow[2000];
+  size_t i, size = 0, seed = 7;
+  CU_ASSERT_EQUAL_FATAL(0, ulist_init(&list, NULL, NULL));
+  for (i = 0; i < 1000; ++i) {
+    CU_ASSERT_EQUAL(0, ulist_push_back(&list, test_data + i % 10));
+    shadow[size++] = test_data + i % 10;
+  }
+  /* pushes fill whole nodes */
+  CU_ASSERT_EQUAL((1000 + BLIB_ULIST_NODE_CAP - 1) / BLIB_ULIST_NODE_CAP,
+                  list.node_count);
+
+  /* mixed insertions and deletions at pseudo-random positions */
+  for (i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    size_t at = seed / 65536 % (size + 1);
+    if (i % 3 == 2 && at < size) {
+      CU_ASSERT_PTR_EQUAL(shadow[at], ulist_extract(&list, at));
+      memmove(shadow + at, shadow + at + 1, sizeof(void *) * (--size - at));
+    } else if (size < 2000) {
+      CU_ASSERT_EQUAL(0, ulist_insert(&list, test_data + i % 10, at));
+      memmove(shadow + at + 1, shadow + at, sizeof(void *) * (size++ - at));
+      shadow[at] = test_data + i % 10;
+    }
+  }
+  CU_ASSERT_EQUAL_FATAL(size, ulist_size(&list));
+  for (i = 0; i < size; ++i)
+    CU_ASSERT_PTR_EQUAL(shadow[i], ulist_get(&list, i));
+
+  /* interior nodes stay at least half full */
+  UNode *node;
+  size_t total = 0;
+  for (node = list.head; node; node = node->next) {
+    if (node != list.head && node != list.tail)
+      CU_ASSERT_TRUE(node->count >= BLIB_ULIST_NODE_CAP / 2);
+    total += node->count;
+  }
+  CU_ASSERT_EQUAL(size, total);
+
+  size_t first = size, last = size;
+  for (i = 0; i < size; ++i) {
+    if (shadow[i] != test_data + 4) continue;
+    if (first == size) first = i;
+    last = i;
+  }
+  CU_ASSERT_EQUAL(first, ulist_find(&list, test_data + 4));
+  CU_ASSERT_EQUAL(last, ulist_rfind(&list, test_data + 4));
+  while (!ulist_empty(&list))
+    CU_ASSERT_PTR_EQUAL(shadow[--size], ulist_pop_back(&list));
+  CU_ASSERT_EQUAL(0, list.node_count);
+  CU_ASSERT_PTR_NULL(ulist_pop_front(&list));
+  CU_ASSERT_EQUAL(BLIB_EMPTY, ulist_status(&list));
+  CU_ASSERT_EQUAL(0, ulist_destroy(&list));
+}
+
+struct timer {
+  int deadline;
+  ListLink link;
+};
+
+void expire_timer(ListLink *link) {
+  BLIB_CONTAINER_OF(link, struct timer, link)->deadline = -1;
+}
+
+void test_ilist_links(void) {
+  static IntrusiveList list = BLIB_ILIST_INIT(list);
+  struct timer timers[5] = {{0, {NULL, NULL}}};
+  ListLink *link, *next;
+  int i;
+  CU_ASSERT_TRUE(ilist_empty(&list));
+  for (i = 0; i < 5; ++i) {
+    timers[i].deadline = i;
+    CU_ASSERT_EQUAL(0, ilist_push_back(&list, &timers[i].link));
+  }
+  CU_ASSERT_EQUAL(-1, ilist_push_front(&list, &timers[2].link));
+  CU_ASSERT_EQUAL(5, ilist_size(&list));
+
+  /* unlinking needs only the object */
+  CU_ASSERT_EQUAL(0, ilist_unlink(&list, &timers[2].link));
+  CU_ASSERT_FALSE(ilist_linked(&timers[2].link));
+  CU_ASSERT_EQUAL(0, ilist_insert_after(&list, &timers[4].link,
+                                        &timers[2].link));
+  CU_ASSERT_EQUAL(0, ilist_rotate_backwards(&list));
+  CU_ASSERT_EQUAL(0, ilist_rotate_backwards(&list));
+  CU_ASSERT_EQUAL(0, ilist_rotate_forwards(&list));
+
+  /* 2 0 1 3 4 */
+  int expected[5] = {2, 0, 1, 3, 4};
+  i = 0;
+  ILIST_FOREACH(link, next, &list) {
+    CU_ASSERT_EQUAL(expected[i++],
+                    BLIB_CONTAINER_OF(link, struct timer, link)->deadline);
+  }
+  link = ilist_next(&list, ilist_begin(&list), 3);
+  CU_ASSERT_PTR_EQUAL(&timers[3].link, link);
+  CU_ASSERT_PTR_EQUAL(ilist_end(&list), ilist_next(&list, link, 2));
+  CU_ASSERT_PTR_NULL(ilist_next(&list, link, 3));
+  CU_ASSERT_PTR_NULL(ilist_next(&list, ilist_end(&list), 1));
+  CU_ASSERT_PTR_EQUAL(&timers[4].link, ilist_prev(&list, ilist_end(&list), 1));
+  CU_ASSERT_PTR_EQUAL(&timers[2].link, ilist_prev(&list, link, 3));
+
+  /* unlinking during iteration is safe */
+  ILIST_FOREACH(link, next, &list) {
+    if (BLIB_CONTAINER_OF(link, struct timer, link)->deadline % 2)
+      ilist_unlink(&list, link);
+  }
+  CU_ASSERT_EQUAL(3, ilist_size(&list));
+  CU_ASSERT_PTR_EQUAL(&timers[4].link, ilist_pop_back(&list));
+  ilist_foreach(&list, expire_timer);
+  CU_ASSERT_EQUAL(-1, timers[0].deadline);
+  CU_ASSERT_EQUAL(4, timers[4].deadline);
+  CU_ASSERT_EQUAL(0, ilist_clear(&list, NULL));
+  CU_ASSERT_TRUE(ilist_empty(&list));
+  CU_ASSERT_PTR_NULL(ilist_pop_front(&list));
+  CU_ASSERT_EQUAL(0, ilist_init(&list));
+}
+
+void test_mpmc_bounded(void) {
+  MpmcQueue queue;
+  size_t i;
+  CU_ASSERT_EQUAL_FATAL(0, mpmc_init(&queue, 5));
+  CU_ASSERT_EQUAL(8, mpmc_cap(&queue));
+  CU_ASSERT_PTR_NULL(mpmc_pop_front(&queue));
+  CU_ASSERT_EQUAL(-1, mpmc_push_back(&queue, NULL));
+
+  /* wraps around the ring several times */
+  for (i = 0; i < 20; ++i) {
+    size_t j;
+    for (j = 0; j < 6; ++j)
+      CU_ASSERT_EQUAL(0, mpmc_push_back(&queue, test_data + j));
+    CU_ASSERT_EQUAL(6, mpmc_size(&queue));
+    for (j = 0; j < 6; ++j)
+      CU_ASSERT_PTR_EQUAL(test_data + j, mpmc_pop_front(&queue));
+    CU_ASSERT_PTR_NULL(mpmc_pop_front(&queue));
+  }
+
+  /* full at capacity, and space again after a pop */
+  for (i = 0; i < 8; ++i)
+    CU_ASSERT_EQUAL(0, mpmc_push_back(&queue, test_data + i));
+  CU_ASSERT_EQUAL(-1, mpmc_push_back(&queue, test_data + 8));
+  CU_ASSERT_PTR_EQUAL(test_data, mpmc_pop_front(&queue));
+  CU_ASSERT_EQUAL(0, mpmc_push_back(&queue, test_data + 8));
+  CU_ASSERT_EQUAL(8, mpmc_size(&queue));
+
+  destroyed = 0;
+  CU_ASSERT_EQUAL(0, mpmc_destroy(&queue, count_destroyed));
+  CU_ASSERT_EQUAL(8, destroyed);
+  CU_ASSERT_EQUAL(-1, mpmc_destroy(&queue, NULL));
+}
+
+void test_msq_unbounded(void) {
+  MsQueue queue;
+  size_t i;
+  CU_ASSERT_EQUAL_FATAL(0, msq_init(&queue));
+  CU_ASSERT_TRUE(msq_empty(&queue));
+  CU_ASSERT_PTR_NULL(msq_pop_front(&queue));
+  CU_ASSERT_EQUAL(-1, msq_push_back(&queue, NULL));
+
+  /* enough pops to retire nodes past the first scan */
+  for (i = 0; i < 1000; ++i)
+    CU_ASSERT_EQUAL(0, msq_push_back(&queue, test_data + i % 10));
+  CU_ASSERT_FALSE(msq_empty(&queue));
+  for (i = 0; i < 995; ++i)
+    CU_ASSERT_PTR_EQUAL(test_data + i % 10, msq_pop_front(&queue));
+
+  destroyed = 0;
+  CU_ASSERT_EQUAL(0, msq_destroy(&queue, count_destroyed));
+  CU_ASSERT_EQUAL(5, destroyed);
+  CU_ASSERT_EQUAL(-1, msq_destroy(&queue, NULL));
+}
+
+#define QUEUE_PRODUCERS 4
+#define QUEUE_CONSUMERS 4
+#define QUEUE_ITEMS 20000
+static char queue_items[QUEUE_PRODUCERS * QUEUE_ITEMS];
+
+/* each producer pushes its own range of items, and each consumer pops an
+ * equal share, yielding whenever the queue is full or empty
+ */
+typedef struct queue_worker {
+  int (*push)(void *queue, void *element);
+  void *(*pop)(void *queue);
+  void *queue;
+  size_t first;
+  size_t count;
+  size_t sum;
+} QueueWorker;
+
+static int mpmc_push_any(void *queue, void *element) {
+  return mpmc_push_back(queue, element);
+}
+static void *mpmc_pop_any(void *queue) { return mpmc_pop_front(queue); }
+static int msq_push_any(void *queue, void *element) {
+  return msq_push_back(queue, element);
+}
+static void *msq_pop_any(void *queue) { return msq_pop_front(queue); }
+
+static void *queue_producer(void *arg) {
+  QueueWorker *worker = arg;
+  size_t i;
+  for (i = worker->first; i < worker->first + worker->count; ++i)
+    while (worker->push(worker->queue, queue_items + i)) sched_yield();
+  return NULL;
+}
+
+static void *queue_consumer(void *arg) {
+  QueueWorker *worker = arg;
+  size_t i;
+  for (i = 0; i < worker->count; ++i) {
+    char *item;
+    while ((item = worker->pop(worker->queue)) == NULL) sched_yield();
+    worker->sum += (size_t)(item - queue_items);
+  }
+  return NULL;
+}
+
+/* the items all arrive exactly once if their count and sum come out right */
+static void run_queue_threads(int (*push)(void *, void *),
+                              void *(*pop)(void *), void *queue) {
+  QueueWorker workers[QUEUE_PRODUCERS + QUEUE_CONSUMERS];
+  pthread_t threads[QUEUE_PRODUCERS + QUEUE_CONSUMERS];
+  size_t total = QUEUE_PRODUCERS * QUEUE_ITEMS, count = 0, sum = 0;
+  int i;
+  for (i = 0; i < QUEUE_PRODUCERS + QUEUE_CONSUMERS; ++i) {
+    workers[i].push = push;
+    workers[i].pop = pop;
+    workers[i].queue = queue;
+    workers[i].first = (size_t)i * QUEUE_ITEMS;
+    workers[i].count =
+        i < QUEUE_PRODUCERS ? QUEUE_ITEMS : total / QUEUE_CONSUMERS;
+    workers[i].sum = 0;
+    CU_ASSERT_EQUAL_FATAL(
+        0, pthread_create(threads + i, NULL,
+                          i < QUEUE_PRODUCERS ? queue_producer : queue_consumer,
+                          workers + i));
+  }
+  for (i = 0; i < QUEUE_PRODUCERS + QUEUE_CONSUMERS; ++i) {
+    pthread_join(threads[i], NULL);
+    if (i >= QUEUE_PRODUCERS) {
+      count += workers[i].count;
+      sum += workers[i].sum;
+    }
+  }
+  CU_ASSERT_EQUAL(total, count);
+  CU_ASSERT_EQUAL(total * (total - 1) / 2, sum);
+  CU_ASSERT_PTR_NULL(pop(queue));
+}
+
+void test_mpmc_threads(void) {
+  MpmcQueue mpmc;
+  MsQueue msq;
+  CU_ASSERT_EQUAL_FATAL(0, mpmc_init(&mpmc, 64));
+  run_queue_threads(mpmc_push_any, mpmc_pop_any, &mpmc);
+  CU_ASSERT_EQUAL(0, mpmc_destroy(&mpmc, NULL));
+  CU_ASSERT_EQUAL_FATAL(0, msq_init(&msq));
+  run_queue_threads(msq_push_any, msq_pop_any, &msq);
+  CU_ASSERT_TRUE(msq_empty(&msq));
+  CU_ASSERT_EQUAL(0, msq_destroy(&msq, NULL));
+}
+
+void test_spsc_ring(void) {
+  SpscRing ring;
+  void *batch[12];
+  size_t i;
+  CU_ASSERT_EQUAL_FATAL(0, spsc_init(&ring, 8));
+  CU_ASSERT_EQUAL(8, spsc_cap(&ring));
+  CU_ASSERT_PTR_NULL(spsc_try_pop(&ring));
+  CU_ASSERT_EQUAL(-1, spsc_try_push(&ring, NULL));
+
+  for (i = 0; i < 5; ++i)
+    CU_ASSERT_EQUAL(0, spsc_try_push(&ring, test_data + i));
+  for (i = 0; i < 10; ++i) batch[i] = test_data + i;
+  /* only three more fit */
+  CU_ASSERT_EQUAL(3, spsc_push_batch(&ring, batch, 10));
+  CU_ASSERT_EQUAL(-1, spsc_try_push(&ring, test_data));
+  CU_ASSERT_EQUAL(-1, spsc_set_blocking(&ring, 1));
+  CU_ASSERT_EQUAL(8, spsc_size(&ring));
+
+  CU_ASSERT_PTR_EQUAL(test_data, spsc_pop(&ring));
+  CU_ASSERT_EQUAL(0, spsc_push(&ring, test_data + 9));
+  CU_ASSERT_EQUAL(8, spsc_pop_batch(&ring, batch, 12));
+  int expected[8] = {2, 3, 1, 6, 0, 2, 3, 8};
+  for (i = 0; i < 8; ++i) CU_ASSERT_EQUAL(expected[i], *(int *)batch[i]);
+  CU_ASSERT_EQUAL(0, spsc_pop_batch(&ring, batch, 12));
+
+  /* batches wrap around the end of the ring */
+  for (i = 0; i < 10; ++i) batch[i] = test_data + i;
+  CU_ASSERT_EQUAL(6, spsc_push_batch(&ring, batch, 6));
+  CU_ASSERT_EQUAL(4, spsc_pop_batch(&ring, batch + 6, 4));
+  CU_ASSERT_PTR_EQUAL(test_data + 3, batch[9]);
+  destroyed = 0;
+  CU_ASSERT_EQUAL(0, spsc_destroy(&ring, count_destroyed));
+  CU_ASSERT_EQUAL(2, destroyed);
+}
+
+#define SPSC_HANDOFFS 100000
+static char spsc_items[SPSC_HANDOFFS];
+
+static void *spsc_producer(void *ring) {
+  size_t i;
+  for (i = 0; i < SPSC_HANDOFFS; ++i) spsc_push(ring, spsc_items + i);
+  return NULL;
+}
+
+void test_spsc_blocking(void) {
+  SpscRing ring;
+  pthread_t producer;
+  size_t i;
+  int ordered = 1;
+  /* a two-slot ring keeps both sides sleeping on each other */
+  CU_ASSERT_EQUAL_FATAL(0, spsc_init(&ring, 2));
+  CU_ASSERT_EQUAL_FATAL(0, spsc_set_blocking(&ring, 1));
+  CU_ASSERT_EQUAL_FATAL(0,
+                        pthread_create(&producer, NULL, spsc_producer, &ring));
+  for (i = 0; i < SPSC_HANDOFFS; ++i)
+    ordered &= spsc_pop(&ring) == spsc_items + i;
+  pthread_join(producer, NULL);
+  CU_ASSERT(ordered);
+  CU_ASSERT_EQUAL(0, spsc_size(&ring));
+  CU_ASSERT_EQUAL(0, spsc_destroy(&ring, NULL));
+}
+
+void test_heap_queue(void) {
+  Heap heap;
+  HeapHandle handles[10];
+  int keys[10];
+  unsigned arity;
+  size_t i;
+  CU_ASSERT_EQUAL(-1, heap_init(&heap, 3, int_cmp, NULL));
+  for (arity = 2; arity <= 8; arity *= 2) {
+    CU_ASSERT_EQUAL_FATAL(0, heap_init(&heap, arity, int_cmp, NULL));
+    CU_ASSERT_PTR_NULL(heap_pop(&heap));
+    for (i = 0; i < 10; ++i) {
+      keys[i] = test_data[i];
+      CU_ASSERT_EQUAL(0, heap_push(&heap, keys + i, handles + i));
+    }
+    CU_ASSERT_EQUAL(0, *(int *)heap_peek(&heap));
+
+    /* key 9 drops to -1, key 2 is removed, key 0 rises to 10 */
+    keys[7] = -1;
+    CU_ASSERT_EQUAL(0, heap_update(&heap, handles[7]));
+    CU_ASSERT_PTR_EQUAL(keys + 1, heap_remove(&heap, handles[1]));
+    CU_ASSERT_PTR_NULL(heap_remove(&heap, handles[1]));
+    keys[0] = 10;
+    CU_ASSERT_EQUAL(0, heap_update(&heap, handles[0]));
+    CU_ASSERT_PTR_EQUAL(keys + 4, heap_get(&heap, handles[4]));
+
+    int expected[9] = {-1, 1, 3, 4, 5, 6, 7, 8, 10};
+    for (i = 0; i < 9; ++i)
+      CU_ASSERT_EQUAL(expected[i], *(int *)heap_pop(&heap));
+    CU_ASSERT_TRUE(heap_empty(&heap));
+    CU_ASSERT_EQUAL(0, heap_destroy(&heap));
+  }
+
+  /* heapify, then keep the three largest of a stream */
+  ArrayList list;
+  CU_ASSERT_EQUAL_FATAL(0, alist_init(&list, 0));
+  for (i = 0; i < 3; ++i) alist_push(&list, test_data + i);
+  CU_ASSERT_EQUAL_FATAL(0, heap_from_alist(&heap, &list, 0, int_cmp, NULL));
+  CU_ASSERT_TRUE(alist_empty(&list));
+  CU_ASSERT_EQUAL(3, heap_size(&heap));
+  for (i = 3; i < 10; ++i)
+    if (test_data[i] > *(int *)heap_peek(&heap))
+      heap_replace_top(&heap, test_data + i);
+  CU_ASSERT_EQUAL(7, *(int *)heap_pop(&heap));
+  CU_ASSERT_EQUAL(8, *(int *)heap_pop(&heap));
+  CU_ASSERT_EQUAL(9, *(int *)heap_pop(&heap));
+  CU_ASSERT_EQUAL(0, heap_destroy(&heap));
+  alist_destroy(&list, NULL);
+}
+
+void test_wbt_order(void) {
+  WBTree tree;
+  int keys[100];
+  size_t i;
+  CU_ASSERT_EQUAL(-1, wbt_init(&tree, NULL, NULL, NULL));
+  CU_ASSERT_EQUAL_FATAL(0, wbt_init(&tree, NULL, NULL, int_cmp));
+  /* even keys from 0 to 198, inserted out of order */
+  for (i = 0; i < 100; ++i) {
+    keys[i] = (int)((i * 37) % 100) * 2;
+    CU_ASSERT_EQUAL(0, wbt_insert(&tree, keys + i, test_data + i % 10));
+  }
+  CU_ASSERT_EQUAL(0, wbt_insert(&tree, keys, NULL));
+  CU_ASSERT_EQUAL(W_BLIB_ELEMENT_REPLACED, wbt_status(&tree));
+  CU_ASSERT_EQUAL(100, wbt_size(&tree));
+  CU_ASSERT_PTR_NULL(wbt_get(&tree, keys));
+  CU_ASSERT_PTR_EQUAL(test_data + 1, wbt_get(&tree, keys + 1));
+
+  int key = 51;
+  CU_ASSERT_FALSE(wbt_contains(&tree, &key));
+  CU_ASSERT_EQUAL(26, wbt_rank(&tree, &key));
+  CU_ASSERT_EQUAL(52, *(int *)wbt_lower_bound(&tree, &key)->key);
+  key = 52;
+  CU_ASSERT_EQUAL(52, *(int *)wbt_lower_bound(&tree, &key)->key);
+  CU_ASSERT_EQUAL(54, *(int *)wbt_upper_bound(&tree, &key)->key);
+  key = 198;
+  CU_ASSERT_PTR_NULL(wbt_upper_bound(&tree, &key));
+  CU_ASSERT_EQUAL(80, *(int *)wbt_select(&tree, 40)->key);
+  CU_ASSERT_EQUAL(40, wbt_node_rank(wbt_select(&tree, 40)));
+  CU_ASSERT_PTR_NULL(wbt_select(&tree, 100));
+
+  /* delete the multiples of 4 */
+  for (i = 0; i < 100; ++i)
+    if (keys[i] % 4 == 0) CU_ASSERT_EQUAL(0, wbt_delete(&tree, keys + i));
+  CU_ASSERT_EQUAL(-1, wbt_delete(&tree, keys));
+  CU_ASSERT_EQUAL(50, wbt_size(&tree));
+
+  /* [20, 60) now holds 22, 26, ..., 58 */
+  int low = 20, high = 60, expected = 22;
+  WbtRange range;
+  WbtNode *node;
+  CU_ASSERT_EQUAL(10, wbt_count_range(&tree, &low, &high));
+  CU_ASSERT_EQUAL(0, wbt_range(&tree, &range, &low, &high));
+  while ((node = wbt_range_next(&range))) {
+    CU_ASSERT_EQUAL(expected, *(int *)node->key);
+    expected += 4;
+  }
+  CU_ASSERT_EQUAL(62, expected);
+  CU_ASSERT_EQUAL(0, wbt_range(&tree, &range, &high, &low));
+  CU_ASSERT_PTR_NULL(wbt_range_next(&range));
+  CU_ASSERT_EQUAL(198, *(int *)wbt_last(&tree)->key);
+  CU_ASSERT_EQUAL(190, *(int *)wbt_prev(wbt_prev(wbt_last(&tree)))->key);
+  CU_ASSERT_EQUAL(0, wbt_destroy(&tree));
+
+  /* bulk build from sorted keys */
+  ArrayList sorted;
+  CU_ASSERT_EQUAL_FATAL(0, alist_init(&sorted, 0));
+  for (i = 0; i < 100; ++i) {
+    keys[i] = (int)i;
+    alist_push(&sorted, keys + i);
+  }
+  CU_ASSERT_EQUAL_FATAL(
+      0, wbt_from_alist(&tree, &sorted, NULL, NULL, NULL, int_cmp));
+  CU_ASSERT_TRUE(alist_empty(&sorted));
+  CU_ASSERT_EQUAL(100, wbt_size(&tree));
+  for (i = 0; i < 100; ++i)
+    CU_ASSERT_EQUAL((int)i, *(int *)wbt_select(&tree, i)->key);
+  CU_ASSERT_EQUAL(0, wbt_destroy(&tree));
+  alist_push(&sorted, keys + 1);
+  alist_push(&sorted, keys);
+  CU_ASSERT_EQUAL(-1,
+                  wbt_from_alist(&tree, &sorted, NULL, NULL, NULL, int_cmp));
+  alist_destroy(&sorted, NULL);
+}
+
+void test_bpt_index(void) {
+  BPTree tree;
+  BptCursor cursor;
+  uint64_t i;
+  CU_ASSERT_EQUAL_FATAL(0, bpt_init(&tree, NULL));
+  CU_ASSERT_EQUAL(-1, bpt_first(&tree, &cursor));
+  CU_ASSERT_EQUAL(-1, bpt_delete(&tree, 0));
+  /* multiples of 3 below 3000, enough for several levels */
+  for (i = 0; i < 1000; ++i)
+    CU_ASSERT_EQUAL(0, bpt_insert(&tree, (i * 389) % 1000 * 3, test_data));
+  CU_ASSERT_EQUAL(0, bpt_insert(&tree, 30, test_data + 1));
+  CU_ASSERT_EQUAL(W_BLIB_ELEMENT_REPLACED, bpt_status(&tree));
+  CU_ASSERT_EQUAL(1000, bpt_size(&tree));
+  CU_ASSERT_PTR_EQUAL(test_data + 1, bpt_get(&tree, 30));
+  CU_ASSERT_PTR_NULL(bpt_get(&tree, 31));
+  CU_ASSERT_FALSE(bpt_contains(&tree, 3000));
+
+  CU_ASSERT_EQUAL(0, bpt_lower_bound(&tree, 31, &cursor));
+  CU_ASSERT_EQUAL(33, bpt_key(&cursor));
+  CU_ASSERT_EQUAL(0, bpt_upper_bound(&tree, 33, &cursor));
+  CU_ASSERT_EQUAL(36, bpt_key(&cursor));
+  CU_ASSERT_EQUAL(0, bpt_prev(&cursor));
+  CU_ASSERT_EQUAL(0, bpt_prev(&cursor));
+  CU_ASSERT_PTR_EQUAL(test_data + 1, bpt_value(&cursor));
+  CU_ASSERT_EQUAL(-1, bpt_upper_bound(&tree, 2997, &cursor));
+  CU_ASSERT_EQUAL(0, bpt_last(&tree, &cursor));
+  CU_ASSERT_EQUAL(2997, bpt_key(&cursor));
+  CU_ASSERT_EQUAL(-1, bpt_next(&cursor));
+
+  /* delete the odd multiples, leaving multiples of 6 */
+  for (i = 3; i < 3000; i += 6) CU_ASSERT_EQUAL(0, bpt_delete(&tree, i));
+  CU_ASSERT_EQUAL(-1, bpt_delete(&tree, 3));
+  CU_ASSERT_EQUAL(500, bpt_size(&tree));
+  CU_ASSERT_EQUAL(17, bpt_scan(&tree, 1000, 1100, NULL));
+  Vector keys;
+  CU_ASSERT_EQUAL_FATAL(0, VEC_INIT(&keys, uint64_t, 0));
+  CU_ASSERT_EQUAL(0, bpt_keys(&tree, &keys));
+  CU_ASSERT_EQUAL(500, vec_size(&keys));
+  for (i = 0; i < 500; ++i) CU_ASSERT_EQUAL(i * 6, VEC_AT(&keys, uint64_t, i));
+  destroyed = 0;
+  tree.value_destroy = count_destroyed;
+  CU_ASSERT_EQUAL(0, bpt_destroy(&tree));
+  CU_ASSERT_EQUAL(500, destroyed);
+
+  /* bulk load the same keys back */
+  CU_ASSERT_EQUAL_FATAL(0, bpt_from_sorted(&tree, (uint64_t *)keys.data, NULL,
+                                           500, NULL));
+  CU_ASSERT_EQUAL(500, bpt_size(&tree));
+  CU_ASSERT_TRUE(bpt_contains(&tree, 2994));
+  CU_ASSERT_EQUAL(0, bpt_delete(&tree, 0));
+  CU_ASSERT_EQUAL(0, bpt_first(&tree, &cursor));
+  CU_ASSERT_EQUAL(6, bpt_key(&cursor));
+  CU_ASSERT_EQUAL(0, bpt_destroy(&tree));
+  VEC_AT(&keys, uint64_t, 1) = 0;
+  CU_ASSERT_EQUAL(-1, bpt_from_sorted(&tree, (uint64_t *)keys.data, NULL, 500,
+                                      NULL));
+  vec_destroy(&keys, NULL);
+}
+
+void test_art_prefix(void) {
+  ArtTree tree;
+  const char *routes[6] = {"/", "/api", "/api/v1", "/api/v1/users", "/apiary",
+                           "/static"};
+  char key[4] = {0, 0, 0, 0};
+  size_t i, match;
+  CU_ASSERT_EQUAL_FATAL(0, art_init(&tree, NULL));
+  for (i = 0; i < 6; ++i)
+    CU_ASSERT_EQUAL(0, art_insert(&tree, routes[i], strlen(routes[i]),
+                                  test_data + i));
+  CU_ASSERT_EQUAL(0, art_insert(&tree, "/api", 4, test_data + 9));
+  CU_ASSERT_EQUAL(W_BLIB_ELEMENT_REPLACED, art_status(&tree));
+  CU_ASSERT_EQUAL(6, art_size(&tree));
+  CU_ASSERT_PTR_EQUAL(test_data + 9, art_get(&tree, "/api", 4));
+  CU_ASSERT_PTR_NULL(art_get(&tree, "/ap", 3));
+  CU_ASSERT_FALSE(art_contains(&tree, "/api/v", 6));
+
+  CU_ASSERT_PTR_EQUAL(test_data + 2,
+                      art_longest_prefix(&tree, "/api/v1/orders", 14, &match));
+  CU_ASSERT_EQUAL(7, match);
+  CU_ASSERT_PTR_EQUAL(test_data, art_longest_prefix(&tree, "/img", 4, NULL));
+  CU_ASSERT_PTR_NULL(art_longest_prefix(&tree, "api", 3, NULL));
+
+  visited = 0;
+  CU_ASSERT_EQUAL(0, art_foreach_prefix(&tree, "/api", 4, count_visit));
+  CU_ASSERT_EQUAL(4, visited);
+  visited = 0;
+  CU_ASSERT_EQUAL(0, art_foreach_prefix(&tree, "/api/", 5, count_visit));
+  CU_ASSERT_EQUAL(2, visited);
+  visited = 0;
+  CU_ASSERT_EQUAL(0, art_foreach_prefix(&tree, "/x", 2, count_visit));
+  CU_ASSERT_EQUAL(0, visited);
+
+  CU_ASSERT_EQUAL(0, art_delete(&tree, "/api/v1", 7));
+  CU_ASSERT_EQUAL(-1, art_delete(&tree, "/api/v1", 7));
+  CU_ASSERT_PTR_EQUAL(test_data + 3, art_get(&tree, "/api/v1/users", 13));
+  CU_ASSERT_EQUAL(0, art_delete(&tree, "/api", 4));
+  CU_ASSERT_PTR_EQUAL(test_data + 4, art_get(&tree, "/apiary", 7));
+
+  /* enough distinct bytes at one level to grow through every node type,
+   * and to shrink back
+   */
+  static unsigned char bytes[300][2];
+  for (i = 0; i < 300; ++i) {
+    bytes[i][0] = (unsigned char)(i % 256);
+    bytes[i][1] = (unsigned char)(i / 256);
+    CU_ASSERT_EQUAL(0, art_insert(&tree, bytes[i], 2, test_data + i % 10));
+  }
+  CU_ASSERT_EQUAL(304, art_size(&tree));
+  visited = 0;
+  CU_ASSERT_EQUAL(1, art_foreach(&tree, count_visit));
+  for (i = 0; i < 300; i += 2)
+    CU_ASSERT_EQUAL(0, art_delete(&tree, bytes[i], 2));
+  for (i = 1; i < 300; i += 2)
+    CU_ASSERT_PTR_EQUAL(test_data + i % 10, art_get(&tree, bytes[i], 2));
+  CU_ASSERT_PTR_NULL(art_get(&tree, key, 2));
+  destroyed = 0;
+  tree.value_destroy = count_destroyed;
+  CU_ASSERT_EQUAL(0, art_destroy(&tree));
+  CU_ASSERT_EQUAL(154, destroyed);
+}
+
+void test_intern_table(void) {
+  InternTable table;
+  CU_ASSERT(0 == intern_init(&table, 4));
+  CU_ASSERT(0 == intern_count(&table));
+  CU_ASSERT_PTR_NULL(intern_lookup(&table, "walrus", 6));
+  CU_ASSERT(W_BLIB_NOT_FOUND == intern_status(&table));
+
+  char buf[16];
+  strcpy(buf, "walrus");
+  const char *w = intern_cstr(&table, "walrus");
+  CU_ASSERT_PTR_NOT_NULL(w);
+  CU_ASSERT_STRING_EQUAL("walrus", w);
+  CU_ASSERT(6 == intern_size(w));
+  CU_ASSERT_PTR_EQUAL(w, intern_cstr(&table, buf));
+  CU_ASSERT_PTR_EQUAL(w, intern_lookup(&table, buf, 6));
+  CU_ASSERT(1 == intern_count(&table));
+
+  /* prefixes, embedded zeros and the empty string are distinct strings */
+  const char *wal = intern_bytes(&table, buf, 3);
+  const char *z1 = intern_bytes(&table, "a\0b", 3);
+  const char *z2 = intern_bytes(&table, "a\0c", 3);
+  const char *e = intern_bytes(&table, "", 0);
+  CU_ASSERT(wal != w && z1 != z2 && e != w);
+  CU_ASSERT(0 == memcmp(z2, "a\0c", 4));
+  CU_ASSERT(0 == intern_size(e));
+  CU_ASSERT_PTR_EQUAL(e, intern_cstr(&table, ""));
+  CU_ASSERT(5 == intern_count(&table));
+
+  /* growing the Set and the arena leaves the canonical pointers in place */
+  const char *keys[1000];
+  char name[32];
+  int i;
+  for (i = 0; i < 1000; ++i) {
+    sprintf(name, "key-%d", i);
+    keys[i] = intern_cstr(&table, name);
+  }
+  char big[3 * BLIB_INTERN_CHUNK / 8];
+  memset(big, 'x', sizeof(big));
+  const char *b = intern_bytes(&table, big, sizeof(big));
+  CU_ASSERT_PTR_EQUAL(b, intern_bytes(&table, big, sizeof(big)));
+  CU_ASSERT(sizeof(big) == intern_size(b));
+  int same = 1;
+  for (i = 0; i < 1000; ++i) {
+    sprintf(name, "key-%d", i);
+    same &= keys[i] == intern_cstr(&table, name);
+  }
+  CU_ASSERT(same);
+  CU_ASSERT_PTR_EQUAL(w, intern_cstr(&table, "walrus"));
+  CU_ASSERT(1006 == intern_count(&table));
+
+  /* interned keys in a Map, with and without the cached hash */
+  Map m;
+  CU_ASSERT(0 == map_init(&m, 16, NULL, NULL, intern_equal));
+  CU_ASSERT(0 == map_insert(&m, (void *)w, intern_size(w), "pinniped"));
+  CU_ASSERT_STRING_EQUAL("pinniped",
+                         map_get(&m, (void *)w, intern_size(w)));
+  CU_ASSERT(0 != map_set_hasher(&m, intern_hasher));
+  CU_ASSERT(0 == map_clear(&m));
+  CU_ASSERT(0 == map_set_hasher(&m, intern_hasher));
+  for (i = 0; i < 1000; ++i)
+    map_insert(&m, (void *)keys[i], intern_size(keys[i]), (void *)keys[i]);
+  same = 1;
+  for (i = 0; i < 1000; ++i) {
+    sprintf(name, "key-%d", i);
+    const char *k = intern_cstr(&table, name);
+    same &= map_get(&m, (void *)k, intern_size(k)) == keys[i];
+  }
+  CU_ASSERT(same);
+  CU_ASSERT(1000 == map_size(&m));
+  map_destroy(&m);
+
+  /* and in a Set, which also counts its elements */
+  Set s;
+  CU_ASSERT(0 == set_init(&s, 8, NULL, intern_equal));
+  CU_ASSERT(set_empty(&s));
+  CU_ASSERT(0 == set_set_hasher(&s, intern_hasher));
+  CU_ASSERT(0 == set_insert(&s, (void *)w, intern_size(w)));
+  CU_ASSERT(0 == set_insert(&s, (void *)w, intern_size(w)));
+  CU_ASSERT(0 == set_insert(&s, (void *)z1, intern_size(z1)));
+  CU_ASSERT(2 == set_size(&s) && !set_empty(&s));
+  CU_ASSERT(0 == set_rehash(&s, 3));
+  CU_ASSERT_PTR_EQUAL(z1, set_get(&s, (void *)z1, intern_size(z1)));
+  CU_ASSERT_PTR_NULL(set_get(&s, (void *)z2, intern_size(z2)));
+  CU_ASSERT(0 == set_delete(&s, (void *)w, intern_size(w)));
+  CU_ASSERT(1 == set_size(&s));
+  set_destroy(&s);
+
+  CU_ASSERT(0 == intern_destroy(&table));
+}
+
+void test_alloc_arena(void) {
+  Arena arena;
+  CU_ASSERT(0 == arena_init(&arena, 256));
+  CU_ASSERT_PTR_NULL(arena_allocator(NULL));
+  CU_ASSERT(BLIB_INVALID_STRUCT == arena_status(NULL));
+  const BlibAllocator *a = arena_allocator(&arena);
+  CU_ASSERT_PTR_NOT_NULL(a);
+
+  /* allocations are aligned and the latest one resizes in place */
+  char *p = blib_alloc(a, 10);
+  char *q = blib_alloc(a, 3);
+  CU_ASSERT(p && q && q > p && (size_t)(q - p) % sizeof(double) == 0);
+  strcpy(q, "ab");
+  CU_ASSERT_PTR_EQUAL(q, blib_realloc(a, q, 3, 40));
+  CU_ASSERT_STRING_EQUAL("ab", q);
+  blib_free(a, q, 40);
+  CU_ASSERT_PTR_EQUAL(q, blib_alloc(a, 1));
+
+  /* an older allocation moves, and a large one gets a block of its own */
+  char *r = blib_realloc(a, p, 10, 20);
+  CU_ASSERT(r != p && r > q);
+  char *big = blib_calloc(a, 1000);
+  CU_ASSERT(big && big[0] == 0 && big[999] == 0);
+  CU_ASSERT_PTR_EQUAL(r + 32, blib_alloc(a, 8));
+
+  CU_ASSERT(0 == arena_reset(&arena));
+  CU_ASSERT(BLIB_SUCCESS == arena_status(&arena));
+  CU_ASSERT_PTR_NOT_NULL(blib_alloc(a, 8));
+
+  /* containers on the arena are dropped with it, without their destroy */
+  ArrayList al;
+  LinkedList ll;
+  Map m;
+  ArtTree t;
+  BPTree b;
+  static int keys[2000];
+  char name[32];
+  int i;
+  CU_ASSERT(0 == alist_init_alloc(&al, 0, a));
+  CU_ASSERT(0 == llist_init_alloc(&ll, NULL, NULL, a));
+  CU_ASSERT(0 == map_init_alloc(&m, 8, NULL, NULL, NULL, a));
+  CU_ASSERT(0 == art_init_alloc(&t, NULL, a));
+  CU_ASSERT(0 == bpt_init_alloc(&b, NULL, a));
+  for (i = 0; i < 2000; ++i) {
+    keys[i] = i;
+    sprintf(name, "k%d", i);
+    alist_push(&al, keys + i);
+    llist_push_back(&ll, keys + i);
+    map_insert(&m, keys + i, sizeof(int), keys + i);
+    art_insert(&t, name, strlen(name), keys + i);
+    bpt_insert(&b, (uint64_t)i * 7, keys + i);
+  }
+  int same = 2000 == alist_size(&al) && 2000 == llist_size(&ll) &&
+             2000 == map_size(&m) && 2000 == art_size(&t) &&
+             2000 == bpt_size(&b);
+  for (i = 0; i < 2000; i += 37) {
+    sprintf(name, "k%d", i);
+    same &= alist_get(&al, i) == keys + i && llist_get(&ll, i) == keys + i;
+    same &= map_get(&m, keys + i, sizeof(int)) == keys + i;
+    same &= art_get(&t, name, strlen(name)) == keys + i;
+    same &= bpt_get(&b, (uint64_t)i * 7) == keys + i;
+  }
+  CU_ASSERT(same);
+
+  /* as are the bulk-built ones */
+  Heap h;
+  WBTree w;
+  BPTree bb;
+  ArrayList hl, wl;
+  static uint64_t sorted[2000];
+  CU_ASSERT(0 == alist_init_alloc(&hl, 0, a));
+  CU_ASSERT(0 == alist_init_alloc(&wl, 0, a));
+  for (i = 0; i < 2000; ++i) {
+    sorted[i] = (uint64_t)i * 3;
+    alist_push(&hl, keys + 1999 - i);
+    alist_push(&wl, keys + i);
+  }
+  CU_ASSERT(0 == heap_from_alist_alloc(&h, &hl, 4, int_cmp, NULL, a));
+  CU_ASSERT(0 == wbt_from_alist_alloc(&w, &wl, NULL, NULL, NULL, int_cmp, a));
+  CU_ASSERT(0 == bpt_from_sorted_alloc(&bb, sorted, NULL, 2000, NULL, a));
+  CU_ASSERT(h.allocator == a && w.allocator == a && bb.allocator == a);
+  CU_ASSERT_PTR_EQUAL(keys, heap_peek(&h));
+  CU_ASSERT(2000 == wbt_size(&w) && 2000 == bpt_size(&bb));
+  CU_ASSERT_PTR_EQUAL(keys + 1234, wbt_select(&w, 1234)->key);
+  CU_ASSERT(bpt_contains(&bb, 1234 * 3) && !bpt_contains(&bb, 1));
+  CU_ASSERT(0 == arena_destroy(&arena));
+  CU_ASSERT(0 == arena_destroy(&arena));
+}
+
+void test_alloc_pool(void) {
+  Pool pool;
+  CU_ASSERT(0 == pool_init(&pool));
+  const BlibAllocator *a = pool_allocator(&pool);
+  CU_ASSERT_PTR_NOT_NULL(a);
+
+  /* freed blocks are handed out again for sizes of the same class */
+  void *p = blib_alloc(a, 20);
+  void *q = blib_alloc(a, 24);
+  CU_ASSERT(p && q && p != q);
+  blib_free(a, p, 20);
+  CU_ASSERT_PTR_EQUAL(p, blib_alloc(a, 32));
+  CU_ASSERT_PTR_EQUAL(q, blib_realloc(a, q, 24, 30));
+
+  /* moving across classes keeps the contents */
+  memcpy(q, "seal", 5);
+  char *r = blib_realloc(a, q, 30, 600);
+  CU_ASSERT(r && r != q);
+  CU_ASSERT_STRING_EQUAL("seal", r);
+  char *s = blib_realloc(a, r, 600, 5000);
+  CU_ASSERT(s && 0 == memcmp(s, "seal", 5));
+  s = blib_realloc(a, s, 5000, 9000);
+  CU_ASSERT(s && 0 == memcmp(s, "seal", 5));
+  s = blib_realloc(a, s, 9000, 8);
+  CU_ASSERT(s && 0 == memcmp(s, "seal", 5));
+  blib_free(a, s, 8);
+  blib_free(a, p, 32);
+
+  /* a list and a heap on the pool reuse each other's nodes */
+  LinkedList ll;
+  Heap h;
+  static int keys[1000];
+  int i;
+  CU_ASSERT(0 == llist_init_alloc(&ll, NULL, NULL, a));
+  CU_ASSERT(0 == heap_init_alloc(&h, 4, int_cmp, NULL, a));
+  for (i = 0; i < 1000; ++i) {
+    keys[i] = (i * 389) % 1000;
+    llist_push_back(&ll, keys + i);
+    heap_push(&h, keys + i, NULL);
+  }
+  int sorted = 1;
+  for (i = 0; i < 1000; ++i) sorted &= *(int *)heap_pop(&h) == i;
+  CU_ASSERT(sorted);
+  CU_ASSERT(0 == llist_clear(&ll));
+  for (i = 0; i < 1000; ++i) llist_push_front(&ll, keys + i);
+  CU_ASSERT(1000 == llist_size(&ll));
+  CU_ASSERT(0 == llist_destroy(&ll));
+  CU_ASSERT(0 == heap_destroy(&h));
+
+  /* the templated structures take an allocator too */
+  IntArray arr;
+  IntQueue queue;
+  IntMap map;
+  IntSet set;
+  CU_ASSERT(0 == iarr_init_alloc(&arr, 0, a));
+  CU_ASSERT(0 == iqueue_init_alloc(&queue, a));
+  CU_ASSERT(0 == imap_init_alloc(&map, 0, a));
+  CU_ASSERT(0 == iset_init_alloc(&set, 0, a));
+  for (i = 0; i < 1000; ++i) {
+    iarr_push(&arr, i);
+    iqueue_push_back(&queue, i);
+    imap_insert(&map, i, -i);
+    iset_insert(&set, i * 2);
+  }
+  sorted = 1000 == iarr_size(&arr) && 1000 == iqueue_size(&queue) &&
+           1000 == imap_size(&map) && 1000 == iset_size(&set);
+  for (i = 0; i < 1000; i += 7) {
+    sorted &= *iarr_at(&arr, i) == i && *imap_get(&map, i) == -i;
+    sorted &= iset_contains(&set, i * 2) && !iset_contains(&set, i * 2 + 1);
+  }
+  CU_ASSERT(sorted);
+  CU_ASSERT(0 == iarr_destroy(&arr));
+  CU_ASSERT(0 == iqueue_destroy(&queue));
+  CU_ASSERT(0 == imap_destroy(&map));
+  CU_ASSERT(0 == iset_destroy(&set));
+  CU_ASSERT(0 == pool_destroy(&pool));
+  CU_ASSERT(BLIB_INVALID_STRUCT == pool_status(NULL));
+}
+
+void test_clist_stable(void) {
+  ChunkList list;
+  CU_ASSERT_EQUAL_FATAL(0, clist_init(&list, 10));
+  CU_ASSERT_EQUAL(BLIB_CLIST_CHUNK_SIZE, clist_cap(&list));
+  CU_ASSERT_EQUAL(0, clist_insert(&list, test_data + 3, 3, NULL));
+  void **slot = clist_slot(&list, 3);
+  CU_ASSERT_PTR_EQUAL(test_data + 3, *slot);
+
+  /* grow across several chunks; the first slot must not move */
+  size_t i, total = 3 * BLIB_CLIST_CHUNK_SIZE + 5;
+  for (i = 10; i < total; ++i)
+    CU_ASSERT_EQUAL(0, clist_push(&list, test_data + i % 10));
+  CU_ASSERT_EQUAL(total, clist_size(&list));
+  CU_ASSERT_EQUAL(4 * BLIB_CLIST_CHUNK_SIZE, clist_cap(&list));
+  CU_ASSERT_PTR_EQUAL(slot, clist_slot(&list, 3));
+  CU_ASSERT_PTR_EQUAL(test_data + 3, *slot);
+  for (i = 10; i < total; ++i)
+    CU_ASSERT_PTR_EQUAL(test_data + i % 10, clist_get(&list, i));
+  CU_ASSERT_EQUAL(total - 9, clist_count(&list));
+  CU_ASSERT_EQUAL(3, clist_find(&list, test_data + 3, NULL));
+  CU_ASSERT_EQUAL(total - 8, clist_rfind(&list, test_data + 9, NULL));
+
+  /* pop back across a chunk boundary, then release the empty chunks */
+  for (i = 0; i < 6; ++i) CU_ASSERT_EQUAL(0, clist_pop(&list, NULL));
+  CU_ASSERT_PTR_EQUAL(test_data + (total - 7) % 10, clist_peek(&list));
+  CU_ASSERT_EQUAL(0, clist_delete(&list, 3, NULL));
+  CU_ASSERT_PTR_NULL(clist_get(&list, 3));
+  CU_ASSERT_EQUAL(W_BLIB_NOT_FOUND, clist_status(&list));
+  CU_ASSERT_EQUAL(0, clist_resize(&list, 5, NULL));
+  CU_ASSERT_EQUAL(BLIB_CLIST_CHUNK_SIZE, clist_cap(&list));
+  CU_ASSERT_EQUAL(0, clist_count(&list));
+  CU_ASSERT_PTR_NULL(clist_get(&list, 5));
+  CU_ASSERT_EQUAL(BLIB_OUT_OF_BOUNDS, clist_status(&list));
+  CU_ASSERT_EQUAL(0, clist_destroy(&list, NULL));
+}
+
+void test_deque_ring(void) {
+  Deque deque;
+  CU_ASSERT_EQUAL_FATAL(0, deque_init(&deque, NULL, NULL));
+  CU_ASSERT_PTR_NULL(deque_pop_front(&deque));
+  CU_ASSERT_EQUAL(BLIB_EMPTY, deque_status(&deque));
+
+  /* wrap around the start of the buffer, then grow while wrapped */
+  size_t i;
+  for (i = 0; i < 5; ++i)
+    CU_ASSERT_EQUAL(0, deque_push_back(&deque, test_data + i));
+  for (i = 5; i < 10; ++i)
+    CU_ASSERT_EQUAL(0, deque_push_front(&deque, test_data + i));
+  CU_ASSERT_EQUAL(10, deque_size(&deque));
+  CU_ASSERT_EQUAL(16, deque.cap);
+  for (i = 0; i < 5; ++i) {
+    CU_ASSERT_PTR_EQUAL(test_data + 9 - i, deque_get(&deque, i));
+    CU_ASSERT_PTR_EQUAL(test_data + i, deque_get(&deque, i + 5));
+  }
+  CU_ASSERT_EQUAL(2, deque_find(&deque, test_data + 7));
+  CU_ASSERT_EQUAL(8, deque_rfind(&deque, test_data + 3));
+  CU_ASSERT_EQUAL((size_t)-1, deque_find(&deque, test_data + 10));
+
+  CU_ASSERT_EQUAL(0, deque_rotate_forwards(&deque));
+  CU_ASSERT_PTR_EQUAL(test_data + 8, deque_front(&deque));
+  CU_ASSERT_PTR_EQUAL(test_data + 9, deque_back(&deque));
+  CU_ASSERT_EQUAL(0, deque_rotate_backwards(&deque));
+  CU_ASSERT_PTR_EQUAL(test_data + 9, deque_front(&deque));
+  CU_ASSERT_PTR_EQUAL(test_data + 4, deque_back(&deque));
+
+  /* use it as a queue */
+  for (i = 0; i < 5; ++i)
+    CU_ASSERT_PTR_EQUAL(test_data + 9 - i, deque_pop_front(&deque));
+  for (i = 0; i < 100; ++i) {
+    size_t expected = i < 5 ? i : (i + 5) % 10;
+    CU_ASSERT_EQUAL(0, deque_push_back(&deque, test_data + i % 10));
+    CU_ASSERT_PTR_EQUAL(test_data + expected, deque_pop_front(&deque));
+    if (i == 42) CU_ASSERT_EQUAL(0, deque_reserve(&deque, 17));
+  }
+  CU_ASSERT_EQUAL(32, deque.cap);
+  CU_ASSERT_EQUAL(5, deque_size(&deque));
+  CU_ASSERT_PTR_EQUAL(test_data + 9, deque_pop_back(&deque));
+  CU_ASSERT_PTR_NULL(deque_get(&deque, 4));
+  CU_ASSERT_EQUAL(BLIB_OUT_OF_BOUNDS, deque_status(&deque));
+
+  /* capacities whose byte count overflows are refused */
+  CU_ASSERT_EQUAL(-1, deque_reserve(&deque, (size_t)-1 / sizeof(void *) + 1));
+  CU_ASSERT_EQUAL(BLIB_INVALID_SIZE, deque_status(&deque));
+  CU_ASSERT_EQUAL(-1, deque_reserve(&deque, (size_t)-1));
+  CU_ASSERT_EQUAL(32, deque.cap);
+  CU_ASSERT_EQUAL(4, deque_size(&deque));
+  CU_ASSERT_EQUAL(0, deque_destroy(&deque));
+}
+
+struct point {
+  int x;
+  int y;
+};
+
+int compare_point_x(const void *p1, const void *p2) {
+  return ((const struct point *)p1)->x - ((const struct point *)p2)->x;
+}
+
+void test_vec_values(void) {
+  Vector vec;
+  CU_ASSERT_EQUAL_FATAL(0, VEC_INIT(&vec, int, 0));
+  size_t i;
+  for (i = 0; i < 10; ++i) CU_ASSERT_EQUAL(0, vec_push(&vec, test_data + i));
+  CU_ASSERT_EQUAL(10, vec_size(&vec));
+  CU_ASSERT_EQUAL(16, vec_cap(&vec));
+  for (i = 0; i < 10; ++i) {
+    CU_ASSERT_EQUAL(test_data[i], VEC_AT(&vec, int, i));
+    CU_ASSERT_EQUAL(test_data[i], *(int *)vec_get(&vec, i));
+  }
+  /* elements are copies, not the pointers that were pushed */
+  CU_ASSERT_PTR_NOT_EQUAL(test_data + 4, vec_get(&vec, 4));
+
+  int target = 9;
+  CU_ASSERT_EQUAL(7, vec_find(&vec, &target, NULL));
+  CU_ASSERT_EQUAL(7, vec_rfind(&vec, &target, NULL));
+  CU_ASSERT_EQUAL(0, vec_delete(&vec, 7, NULL));
+  CU_ASSERT_EQUAL(9, vec_size(&vec));
+  CU_ASSERT_EQUAL(9, vec_find(&vec, &target, NULL));
+  CU_ASSERT_EQUAL(7, VEC_AT(&vec, int, 7));
+
+  CU_ASSERT_EQUAL(8, *(int *)vec_peek(&vec));
+  CU_ASSERT_EQUAL(0, vec_pop(&vec, NULL));
+  CU_ASSERT_EQUAL(0, vec_resize(&vec, 2, NULL));
+  CU_ASSERT_EQUAL(4, vec_cap(&vec));
+  CU_ASSERT_EQUAL(0, vec_resize(&vec, 5, NULL));
+  CU_ASSERT_EQUAL(0, VEC_AT(&vec, int, 4));
+  CU_ASSERT_PTR_NULL(vec_get(&vec, 5));
+  CU_ASSERT_EQUAL(BLIB_OUT_OF_BOUNDS, vec_status(&vec));
+  CU_ASSERT_EQUAL(0, vec_destroy(&vec, NULL));
+}
+
+/* an allocator that can grow blocks but never shrink them */
+static void *grow_only_realloc(void *context, void *ptr, size_t old_size,
+                               size_t new_size) {
+  (void)context;
+  return new_size < old_size ? NULL : realloc(ptr, new_size);
+}
+
+void test_vec_structs(void) {
+  Vector vec;
+  CU_ASSERT_EQUAL_FATAL(0, VEC_INIT(&vec, struct point, 3));
+  CU_ASSERT_EQUAL(0, VEC_AT(&vec, struct point, 2).y);
+  size_t i;
+  for (i = 0; i < 10; ++i) {
+    struct point p;
+    p.x = test_data[i];
+    p.y = (int)i;
+    CU_ASSERT_EQUAL(0, vec_insert(&vec, &p, i, NULL));
+  }
+  vec_sort(&vec, compare_point_x);
+  for (i = 0; i < 10; ++i) {
+    struct point *p = vec_get(&vec, i);
+    CU_ASSERT_EQUAL((int)i, p->x);
+    CU_ASSERT_EQUAL(test_data[p->y], p->x);
+  }
+
+  /* sizes whose byte count overflows are refused and leave vec intact */
+  CU_ASSERT_EQUAL(-1, vec_resize(&vec, (size_t)-1 / 8 + 1, NULL));
+  CU_ASSERT_EQUAL(BLIB_INVALID_SIZE, vec_status(&vec));
+  CU_ASSERT_EQUAL(-1, vec_resize(&vec, (size_t)-1, NULL));
+  CU_ASSERT_EQUAL(10, vec_size(&vec));
+  CU_ASSERT_EQUAL(0, vec_destroy(&vec, NULL));
+  CU_ASSERT_EQUAL(-1, vec_init(&vec, 16, (size_t)-1 / 16 + 1));
+
+  /* a shrink the allocator refuses still drops the elements, once */
+  BlibAllocator grow_only = {NULL, grow_only_realloc, NULL, NULL};
+  grow_only.allocate = blib_malloc_allocator.allocate;
+  grow_only.release = blib_malloc_allocator.release;
+  CU_ASSERT_EQUAL_FATAL(0, vec_init_alloc(&vec, sizeof(int), 64, &grow_only));
+  destroyed = 0;
+  CU_ASSERT_EQUAL(0, vec_resize(&vec, 2, count_destroyed));
+  CU_ASSERT_EQUAL(62, destroyed);
+  CU_ASSERT_EQUAL(2, vec_size(&vec));
+  CU_ASSERT_EQUAL(0, vec_destroy(&vec, count_destroyed));
+  CU_ASSERT_EQUAL(64, destroyed);
+}
+
+void test_tmpl_alist(void) {
+  IntArray arr;
+  CU_ASSERT_EQUAL_FATAL(0, iarr_init(&arr, 0));
+  size_t i;
+  for (i = 0; i < 1000; ++i) CU_ASSERT_EQUAL(0, iarr_push(&arr, rand() % 100));
+  CU_ASSERT_EQUAL(1000, iarr_size(&arr));
+  CU_ASSERT_EQUAL(1024, arr.cap);
+  iarr_sort(&arr);
+  for (i = 1; i < 1000; ++i) CU_ASSERT(*iarr_at(&arr, i - 1) <= arr.data[i]);
+  CU_ASSERT_PTR_NULL(iarr_at(&arr, 1000));
+
+  CU_ASSERT_EQUAL(0, iarr_resize(&arr, 10));
+  for (i = 0; i < 10; ++i) CU_ASSERT_EQUAL(0, iarr_set(&arr, i, test_data[i]));
+  CU_ASSERT_EQUAL(7, iarr_find(&arr, 9));
+  CU_ASSERT_EQUAL(10, iarr_find(&arr, 10));
+  iarr_sort(&arr);
+  for (i = 0; i < 10; ++i) CU_ASSERT_EQUAL((int)i, arr.data[i]);
+  int out;
+  CU_ASSERT_EQUAL(0, iarr_pop(&arr, &out));
+  CU_ASSERT_EQUAL(9, out);
+  CU_ASSERT_EQUAL(0, iarr_destroy(&arr));
+}
+
+void test_tmpl_llist(void) {
+  IntQueue queue;
+  CU_ASSERT_EQUAL_FATAL(0, iqueue_init(&queue));
+  size_t i;
+  for (i = 0; i < 10; ++i)
+    CU_ASSERT_EQUAL(0, iqueue_push_back(&queue, test_data[i]));
+  CU_ASSERT_EQUAL(0, iqueue_push_front(&queue, -1));
+  CU_ASSERT_EQUAL(11, iqueue_size(&queue));
+  CU_ASSERT_EQUAL(-1, *iqueue_front(&queue));
+  CU_ASSERT_EQUAL(8, *iqueue_back(&queue));
+  CU_ASSERT_EQUAL(5, iqueue_find(&queue, 6));
+
+  int out;
+  CU_ASSERT_EQUAL(0, iqueue_pop_front(&queue, &out));
+  CU_ASSERT_EQUAL(-1, out);
+  for (i = 0; i < 10; ++i) {
+    CU_ASSERT_EQUAL(0, iqueue_pop_front(&queue, &out));
+    CU_ASSERT_EQUAL(test_data[i], out);
+  }
+  CU_ASSERT_NOT_EQUAL(0, iqueue_pop_back(&queue, &out));
+  CU_ASSERT_PTR_NULL(iqueue_front(&queue));
+  CU_ASSERT_EQUAL(0, iqueue_destroy(&queue));
+}
+
+void test_tmpl_map(void) {
+  IntMap imap;
+  CU_ASSERT_EQUAL_FATAL(0, imap_init(&imap, 0));
+  int i;
+  for (i = 0; i < 1000; ++i) CU_ASSERT_EQUAL(0, imap_insert(&imap, i, i * i));
+  CU_ASSERT_EQUAL(1000, imap_size(&imap));
+  for (i = 0; i < 1000; i += 2) CU_ASSERT_EQUAL(0, imap_delete(&imap, i));
+  CU_ASSERT_NOT_EQUAL(0, imap_delete(&imap, 0));
+  CU_ASSERT_EQUAL(500, imap_size(&imap));
+  for (i = 0; i < 1000; ++i) {
+    int *value = imap_get(&imap, i);
+    if (i % 2) {
+      CU_ASSERT_PTR_NOT_NULL(value);
+      if (value) CU_ASSERT_EQUAL(i * i, *value);
+    } else {
+      CU_ASSERT_PTR_NULL(value);
+    }
+  }
+  CU_ASSERT_EQUAL(0, imap_insert(&imap, 1, 5));
+  CU_ASSERT_EQUAL(5, *imap_get(&imap, 1));
+  CU_ASSERT_EQUAL(500, imap_size(&imap));
+  CU_ASSERT_EQUAL(0, imap_destroy(&imap));
+}
+
+void test_tmpl_set(void) {
+  IntSet iset;
+  CU_ASSERT_EQUAL_FATAL(0, iset_init(&iset, 4));
+  size_t i;
+  for (i = 0; i < 10; ++i) {
+    CU_ASSERT_EQUAL(0, iset_insert(&iset, test_data[i]));
+    CU_ASSERT_EQUAL(0, iset_insert(&iset, test_data[i]));
+  }
+  CU_ASSERT_EQUAL(10, iset_size(&iset));
+  CU_ASSERT_TRUE(iset_contains(&iset, 7));
+  CU_ASSERT_EQUAL(0, iset_delete(&iset, 7));
+  CU_ASSERT_FALSE(iset_contains(&iset, 7));
+  CU_ASSERT_FALSE(iset_contains(&iset, 10));
+  for (i = 0; i < 10; ++i)
+    CU_ASSERT_EQUAL(test_data[i] != 7, iset_contains(&iset, test_data[i]));
+  CU_ASSERT_EQUAL(0, iset_destroy(&iset));
+}
+
 int init_map_suite(void) {
   /* use integers for keys */
   map = malloc(sizeof(Map));
@@ -435,6 +2042,22 @@ int main() {
   CU_pSuite liter_pSuite = NULL;
   CU_pSuite alist_pSuite = NULL;
   CU_pSuite map_pSuite = NULL;
+  CU_pSuite vec_pSuite = NULL;
+  CU_pSuite tmpl_pSuite = NULL;
+  CU_pSuite clist_pSuite = NULL;
+  CU_pSuite deque_pSuite = NULL;
+  CU_pSuite smap_pSuite = NULL;
+  CU_pSuite gbuf_pSuite = NULL;
+  CU_pSuite ulist_pSuite = NULL;
+  CU_pSuite ilist_pSuite = NULL;
+  CU_pSuite mpmc_pSuite = NULL;
+  CU_pSuite spsc_pSuite = NULL;
+  CU_pSuite heap_pSuite = NULL;
+  CU_pSuite wbt_pSuite = NULL;
+  CU_pSuite bpt_pSuite = NULL;
+  CU_pSuite art_pSuite = NULL;
+  CU_pSuite intern_pSuite = NULL;
+  CU_pSuite alloc_pSuite = NULL;
 
   /* initialize the CUnit test registry */
   if (CUE_SUCCESS != CU_initialize_registry()) return CU_get_error();
@@ -447,8 +2070,29 @@ int main() {
   alist_pSuite =
       CU_add_suite("ArrayList Suite", init_alist_suite, clean_alist_suite);
   map_pSuite = CU_add_suite("Map Suite", init_map_suite, clean_map_suite);
+  vec_pSuite = CU_add_suite("Vector Suite", NULL, NULL);
+  tmpl_pSuite = CU_add_suite("Template Suite", NULL, NULL);
+  clist_pSuite = CU_add_suite("ChunkList Suite", NULL, NULL);
+  deque_pSuite = CU_add_suite("Deque Suite", NULL, NULL);
+  smap_pSuite = CU_add_suite("SlotMap Suite", NULL, NULL);
+  gbuf_pSuite = CU_add_suite("GapBuffer Suite", NULL, NULL);
+  ulist_pSuite = CU_add_suite("UnrolledList Suite", NULL, NULL);
+  ilist_pSuite = CU_add_suite("IntrusiveList Suite", NULL, NULL);
+  mpmc_pSuite = CU_add_suite("Concurrent Queue Suite", NULL, NULL);
+  spsc_pSuite = CU_add_suite("SPSC Ring Suite", NULL, NULL);
+  heap_pSuite = CU_add_suite("Heap Suite", NULL, NULL);
+  wbt_pSuite = CU_add_suite("WBTree Suite", NULL, NULL);
+  bpt_pSuite = CU_add_suite("BPTree Suite", NULL, NULL);
+  art_pSuite = CU_add_suite("ArtTree Suite", NULL, NULL);
+  intern_pSuite = CU_add_suite("Intern Suite", NULL, NULL);
+  alloc_pSuite = CU_add_suite("Allocator Suite", NULL, NULL);
   if (NULL == llist_pSuite || NULL == liter_pSuite || NULL == alist_pSuite ||
-      NULL == map_pSuite) {
+      NULL == map_pSuite || NULL == vec_pSuite || NULL == tmpl_pSuite ||
+      NULL == clist_pSuite || NULL == deque_pSuite || NULL == smap_pSuite ||
+      NULL == gbuf_pSuite || NULL == ulist_pSuite || NULL == ilist_pSuite ||
+      NULL == mpmc_pSuite || NULL == spsc_pSuite || NULL == heap_pSuite ||
+      NULL == wbt_pSuite || NULL == bpt_pSuite || NULL == art_pSuite ||
+      NULL == intern_pSuite || NULL == alloc_pSuite) {
     CU_cleanup_registry();
     return CU_get_error();
   }
@@ -466,6 +2110,10 @@ int main() {
        CU_add_test(llist_pSuite, "error handling", test_llist_errors)) ||
       (NULL ==
        CU_add_test(llist_pSuite, "operation sequence", test_llist_sequence)) ||
+      (NULL ==
+       CU_add_test(llist_pSuite, "node traversal", test_llist_traversal)) ||
+      (NULL == CU_add_test(llist_pSuite, "merge sort", test_llist_sort)) ||
+      (NULL == CU_add_test(llist_pSuite, "bulk functions", test_llist_bulk)) ||
       /* list iterator tests */
       (NULL ==
        CU_add_test(liter_pSuite, "list iter creation", test_liter_creation)) ||
@@ -473,6 +2121,10 @@ int main() {
        CU_add_test(liter_pSuite, "list iter mutation", test_liter_mutation)) ||
       (NULL ==
        CU_add_test(liter_pSuite, "list iteration", test_liter_iteration)) ||
+      (NULL ==
+       CU_add_test(liter_pSuite, "value iterators", test_liter_values)) ||
+      (NULL ==
+       CU_add_test(liter_pSuite, "push front", test_liter_push_front)) ||
       /* array list tests */
       (NULL ==
        CU_add_test(alist_pSuite, "default values", test_alist_defaults)) ||
@@ -481,9 +2133,58 @@ int main() {
        CU_add_test(alist_pSuite, "resize functions", test_alist_resize)) ||
       (NULL ==
        CU_add_test(alist_pSuite, "stack functions", test_alist_stack)) ||
+      (NULL == CU_add_test(alist_pSuite, "scan functions", test_alist_scan)) ||
+      (NULL ==
+       CU_add_test(alist_pSuite, "capacity functions", test_alist_capacity)) ||
+      (NULL == CU_add_test(alist_pSuite, "small lists", test_alist_small)) ||
+      (NULL == CU_add_test(alist_pSuite, "compaction", test_alist_compact)) ||
+      (NULL ==
+       CU_add_test(alist_pSuite, "range operations", test_alist_range)) ||
       /* map tests */
       (NULL == CU_add_test(map_pSuite, "basic functions", test_map_basic)) ||
-      (NULL == CU_add_test(map_pSuite, "bucket filling", test_map_buckets))) {
+      (NULL == CU_add_test(map_pSuite, "bucket filling", test_map_buckets)) ||
+      /* vector tests */
+      (NULL == CU_add_test(vec_pSuite, "value elements", test_vec_values)) ||
+      (NULL == CU_add_test(vec_pSuite, "struct elements", test_vec_structs)) ||
+      /* template tests */
+      (NULL == CU_add_test(tmpl_pSuite, "array list", test_tmpl_alist)) ||
+      (NULL == CU_add_test(tmpl_pSuite, "linked list", test_tmpl_llist)) ||
+      (NULL == CU_add_test(tmpl_pSuite, "map", test_tmpl_map)) ||
+      (NULL == CU_add_test(tmpl_pSuite, "set", test_tmpl_set)) ||
+      /* chunk list tests */
+      (NULL ==
+       CU_add_test(clist_pSuite, "stable addresses", test_clist_stable)) ||
+      /* deque tests */
+      (NULL == CU_add_test(deque_pSuite, "ring buffer", test_deque_ring)) ||
+      /* slot map tests */
+      (NULL == CU_add_test(smap_pSuite, "handles", test_smap_handles)) ||
+      /* gap buffer tests */
+      (NULL == CU_add_test(gbuf_pSuite, "clustered edits", test_gbuf_edits)) ||
+      /* unrolled list tests */
+      (NULL == CU_add_test(ulist_pSuite, "mixed edits", test_ulist_edits)) ||
+      /* intrusive list tests */
+      (NULL == CU_add_test(ilist_pSuite, "embedded links", test_ilist_links)) ||
+      /* concurrent queue tests */
+      (NULL == CU_add_test(mpmc_pSuite, "bounded ring", test_mpmc_bounded)) ||
+      (NULL == CU_add_test(mpmc_pSuite, "michael-scott", test_msq_unbounded)) ||
+      (NULL == CU_add_test(mpmc_pSuite, "threads", test_mpmc_threads)) ||
+      /* spsc ring tests */
+      (NULL == CU_add_test(spsc_pSuite, "handoffs", test_spsc_ring)) ||
+      (NULL == CU_add_test(spsc_pSuite, "blocking", test_spsc_blocking)) ||
+      /* heap tests */
+      (NULL == CU_add_test(heap_pSuite, "priority queue", test_heap_queue)) ||
+      /* weight-balanced tree tests */
+      (NULL == CU_add_test(wbt_pSuite, "ordered map", test_wbt_order)) ||
+      /* b+tree tests */
+      (NULL == CU_add_test(bpt_pSuite, "ordered index", test_bpt_index)) ||
+      /* radix tree tests */
+      (NULL == CU_add_test(art_pSuite, "prefix queries", test_art_prefix)) ||
+      /* intern tests */
+      (NULL == CU_add_test(intern_pSuite, "canonical strings",
+                           test_intern_table)) ||
+      /* allocator tests */
+      (NULL == CU_add_test(alloc_pSuite, "arena", test_alloc_arena)) ||
+      (NULL == CU_add_test(alloc_pSuite, "pool", test_alloc_pool))) {
     CU_cleanup_registry();
     return CU_get_error();
   }